@@ -1,6 +1,6 @@
 #ifndef CONVEX_HULL_H
 #define CONVEX_HULL_H
-#include "raylib.h"
+#include "hull_core.h"
 #include "doubly_linked_list.h"
 #include "geometry.h"
 
@@ -16,21 +16,34 @@ typedef struct ConvexShapeEdge {
   int indices[2];
 } ConvexShapeEdge;
 
+typedef enum HullEngine {
+  HULL_ENGINE_INCREMENTAL = 0, // Tests every face on every insertion, O(n * F)
+  HULL_ENGINE_CONFLICT,        // Face adjacency + per-face conflict lists, only the visible region is touched
+  HULL_ENGINE_COUNT
+} HullEngine;
+
 typedef struct ConvexShape
 {
   int vertexCount;
-  Vector3* vertices;
+  HullVec3* vertices;
   int triangleCount;
   ConvexShapeTriangle* triangles;
+  int edgeCount;
+  ConvexShapeEdge* edges; // Only for collinear input: the segment between its two ends, there are no triangles then
 } ConvexShape;
 
-void CreateRandomVertices(Vector3 v[], int n, int seed);
-ConvexShape *CreateConvexShape(Vector3 v[], int n, int step);
+// Coplanar points give a flat, double-sided polygon: every triangle of one side is reversed on the other.
+// Collinear points give a segment in edges. NULL when there are not two distinct points.
+ConvexShape *CreateConvexShape(HullVec3 v[], int n, int step);
+ConvexShape *CreateConvexShapeEx(HullVec3 v[], int n, int step, HullEngine engine);
+// Exact hull of the points snapped to a grid of gridStep, the shape holds the snapped points
+ConvexShape *CreateConvexShapeQuantized(HullVec3 v[], int n, int step, HullEngine engine, float gridStep);
+// Exact hull of double points (see HullBuildBeginDouble), the shape holds them rounded to float
+ConvexShape *CreateConvexShapeDouble(HullVec3d v[], int n, int step, HullEngine engine);
+// Hull of an epsilon-kernel of the points (see hull_kernel.h), within epsilon times the bounding box diagonal
+// of the exact hull and never outside it. The shape holds the input points and indexes them like the exact
+// shapes, only kernel points are used; the face count depends only on epsilon.
+ConvexShape *CreateConvexShapeApprox(HullVec3 v[], int n, int step, HullEngine engine, float epsilon);
 void ClearConvexShape(ConvexShape* convexSshape);
-void DrawConvex(ConvexShape* convexShape, Vector3 position, Color color, Vector3 scale);
-void DrawConvexWires(ConvexShape* convexShape, Vector3 position, Color color, Vector3 scale);
-bool CanSee(Triangle trig, Vector3 p);
-void DrawVertices(Vector3 v[], int n);
-void DrawVertexCoords(Vector3 v[], int n, Camera camera);
-void DrawVertexIndices(Vector3 v[], int n, Camera camera);
+bool CanSee(Triangle trig, HullVec3 p);
 #endif
\ No newline at end of file
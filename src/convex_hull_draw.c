@@ -0,0 +1,140 @@
+#include "convex_hull_draw.h"
+#include "rlgl.h"
+
+static Triangle fConvexShapeTriangleToTriangle(ConvexShapeTriangle *triangle, HullVec3 vertices[]){
+  return (Triangle){
+    vertices[triangle->indices[0]],
+    vertices[triangle->indices[1]],
+    vertices[triangle->indices[2]]
+  };
+}
+
+void CreateRandomVertices(HullVec3 v[], int n, int seed){
+  int maxExtent = 5; 
+
+  SetRandomSeed(seed);
+  for (int i = 0; i < n; i++)
+  {
+    v[i] = (HullVec3){
+      GetRandomValue(-100, 100) / 100.0f * maxExtent,
+      GetRandomValue(-100, 100) / 100.0f * maxExtent,
+      GetRandomValue(-100, 100) / 100.0f * maxExtent
+    };
+  }
+}
+
+void DrawConvex(ConvexShape *convexShape, Vector3 position, Color color, Vector3 scale)
+{
+  // Draw Debug Normals
+  bool drawDebugNormals = convexShape->triangleCount <= MAX_DEBUG_NORMALS;
+  if (drawDebugNormals){
+    for (int i = 0; i < convexShape->triangleCount; i++)
+    {
+      Triangle trig = fConvexShapeTriangleToTriangle(&convexShape->triangles[i], convexShape->vertices);
+      HullVec3 centerPos = HullVec3Add(HullVec3Add(trig.p1, trig.p2), trig.p3);
+      centerPos = HullVec3Scale(centerPos, 1.0f / 3.0f);
+      HullVec3 normal = GetTriangleNormal(trig);
+      DrawLine3D(HullVec3ToVector3(centerPos), HullVec3ToVector3(HullVec3Add(centerPos, normal)), GREEN);
+      DrawSphere(HullVec3ToVector3(centerPos), 0.05f, GREEN);
+    }
+  }
+  rlPushMatrix();
+    // NOTE: Transformation is applied in inverse order (scale -> rotate -> translate)
+    rlTranslatef(position.x, position.y, position.z);
+    // rlRotatef(45, 0, 1, 0);
+    rlScalef(scale.x, scale.y, scale.z); // NOTE: Vertices are directly scaled on definition
+    rlBegin(RL_TRIANGLES);
+      rlColor4ub(color.r, color.g, color.b, color.a);
+
+      for (int i = 0; i < convexShape->triangleCount; i++)
+      {
+        Triangle trig = fConvexShapeTriangleToTriangle(&convexShape->triangles[i], convexShape->vertices);
+        HullVec3 a = trig.p1;
+        HullVec3 b = trig.p2;
+        HullVec3 c = trig.p3;
+
+        // Normal defined by clockwise order
+        HullVec3 normal = GetTriangleNormal(trig);
+        rlNormal3f(normal.x, normal.y, normal.z);
+        rlVertex3f(a.x, a.y, a.z);
+        rlVertex3f(b.x, b.y, b.z);
+        rlVertex3f(c.x, c.y, c.z);
+      }
+
+    rlEnd();
+  rlPopMatrix();
+}
+
+void DrawConvexWires(ConvexShape *convexShape, Vector3 position, Color color, Vector3 scale){
+  rlPushMatrix();
+  // NOTE: Transformation is applied in inverse order (scale -> rotate -> translate)
+  rlTranslatef(position.x, position.y, position.z);
+  // rlRotatef(45, 0, 1, 0);
+  rlScalef(scale.x, scale.y, scale.z); // NOTE: Vertices are directly scaled on definition
+  rlBegin(RL_LINES);
+  rlColor4ub(color.r, color.g, color.b, color.a);
+
+  for (int i = 0; i < convexShape->triangleCount; i++)
+  {
+    Triangle trig = fConvexShapeTriangleToTriangle(&convexShape->triangles[i], convexShape->vertices);
+    HullVec3 a = trig.p1;
+    HullVec3 b = trig.p2;
+    HullVec3 c = trig.p3;
+
+    rlVertex3f(a.x, a.y, a.z);
+    rlVertex3f(b.x, b.y, b.z);
+
+    rlVertex3f(b.x, b.y, b.z);
+    rlVertex3f(c.x, c.y, c.z);
+
+    rlVertex3f(c.x, c.y, c.z);
+    rlVertex3f(a.x, a.y, a.z);
+  }
+  // Collinear input has only its segment
+  for (int i = 0; i < convexShape->edgeCount; i++)
+  {
+    HullVec3 a = convexShape->vertices[convexShape->edges[i].indices[0]];
+    HullVec3 b = convexShape->vertices[convexShape->edges[i].indices[1]];
+    rlVertex3f(a.x, a.y, a.z);
+    rlVertex3f(b.x, b.y, b.z);
+  }
+
+  rlEnd();
+  rlPopMatrix();
+}
+
+void DrawVertices(HullVec3 v[], int n)
+{
+  // Spheres are far too slow for large clouds, those are drawn as an evenly strided subset of points
+  if (n > MAX_DRAWN_VERTEX_SPHERES)
+  {
+    int stride = n / MAX_DRAWN_VERTEX_POINTS + 1;
+    for (int i = 0; i < n; i += stride)
+    {
+      DrawPoint3D(HullVec3ToVector3(v[i]), BLACK);
+    }
+    return;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    DrawSphere(HullVec3ToVector3(v[i]), 0.05f, BLACK);
+  }
+}
+
+void DrawVertexCoords(HullVec3 v[], int n, Camera camera)
+{
+  for (int i = 0; i < n; i++)
+  {
+    Vector2 screenPos = GetWorldToScreen(HullVec3ToVector3(v[i]), camera);
+    DrawText(TextFormat("%.2f, %.2f, %.2f", v[i].x, v[i].y, v[i].z), (int) screenPos.x + 10, (int) screenPos.y - 4, 8, BLACK);
+  }
+}
+
+void DrawVertexIndices(HullVec3 v[], int n, Camera camera)
+{
+  for (int i = 0; i < n; i++)
+  {
+    Vector2 screenPos = GetWorldToScreen(HullVec3ToVector3(v[i]), camera);
+    DrawText(TextFormat("%d", i), (int) screenPos.x + 10, (int) screenPos.y - 4, 8, BLUE);
+  }
+}
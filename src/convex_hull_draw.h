@@ -0,0 +1,32 @@
+#ifndef CONVEX_HULL_DRAW_H_
+#define CONVEX_HULL_DRAW_H_
+#include "raylib.h"
+#include "convex_hull.h"
+
+// raylib adapter of the hull library: conversions, drawing and raylib's random generator.
+// Drawing needs a window and GL context, the library itself does not.
+
+#define MAX_DRAWN_VERTEX_SPHERES 1000
+#define MAX_DRAWN_VERTEX_POINTS 100000
+#define MAX_DEBUG_NORMALS 2000
+// CreateRandomVertices samples this grid, pass it to CreateConvexShapeQuantized for an exact hull
+#define RANDOM_VERTICES_GRID_STEP 0.05f
+
+static inline Vector3 HullVec3ToVector3(HullVec3 v)
+{
+  return (Vector3){ v.x, v.y, v.z };
+}
+
+static inline HullVec3 Vector3ToHullVec3(Vector3 v)
+{
+  return (HullVec3){ v.x, v.y, v.z };
+}
+
+void CreateRandomVertices(HullVec3 v[], int n, int seed);
+void DrawConvex(ConvexShape* convexShape, Vector3 position, Color color, Vector3 scale);
+void DrawConvexWires(ConvexShape* convexShape, Vector3 position, Color color, Vector3 scale);
+void DrawVertices(HullVec3 v[], int n);
+void DrawVertexCoords(HullVec3 v[], int n, Camera camera);
+void DrawVertexIndices(HullVec3 v[], int n, Camera camera);
+
+#endif
@@ -1,18 +1,18 @@
 #include "doubly_linked_list.h"
 #include "stdlib.h"
-#include "raylib.h"
+#include "hull_core.h"
 #include "string.h"
 
 DoublyLinkedList *DListNew()
 {
-  DoublyLinkedList *newList = MemAlloc(sizeof(DoublyLinkedList));
+  DoublyLinkedList *newList = HullMemAlloc(sizeof(DoublyLinkedList));
   *newList = (DoublyLinkedList){0, NULL, NULL};
   return newList;
 }
 
 DNode *DListNewNode(void *data)
 {
-  DNode *newNode = MemAlloc(sizeof(DNode));
+  DNode *newNode = HullMemAlloc(sizeof(DNode));
   *newNode = (DNode){data, NULL, NULL};
   return newNode;
 }
@@ -73,8 +73,8 @@ void PopFront(DoublyLinkedList *list)
     list->head->previous = NULL;
   }
 
-  MemFree(headTemp->data);
-  MemFree(headTemp);
+  HullMemFree(headTemp->data);
+  HullMemFree(headTemp);
   list->size--;
 }
 
@@ -98,8 +98,8 @@ void PopBack(DoublyLinkedList *list)
     list->tail->next = NULL;
   }
 
-  MemFree(tailTemp->data);
-  MemFree(tailTemp);
+  HullMemFree(tailTemp->data);
+  HullMemFree(tailTemp);
   list->size--;
 }
 
@@ -116,8 +116,8 @@ void DListRemoveNode(DoublyLinkedList *list, DNode *node)
     {
       list->head = NULL;
       list->tail = NULL;
-      MemFree(node->data);
-      MemFree(node);
+      HullMemFree(node->data);
+      HullMemFree(node);
       list->size = 0;
       return;
     }
@@ -140,8 +140,8 @@ void DListRemoveNode(DoublyLinkedList *list, DNode *node)
     {
       list->tail = node->previous;
     }
-    MemFree(node->data);
-    MemFree(node);
+    HullMemFree(node->data);
+    HullMemFree(node);
     list->size--;
   }
 }
@@ -158,7 +158,7 @@ void *DListToArray(DoublyLinkedList *list, size_t elementSize, int *outSize)
     return NULL;
   }
 
-  void **array = MemAlloc(list->size * elementSize);
+  void **array = HullMemAlloc(list->size * elementSize);
   if (!array)
     return NULL;
 
@@ -183,8 +183,8 @@ void DListClear(DoublyLinkedList *list)
   {
     DNode *temp = current;
     current = current->next;
-    MemFree(temp->data);
-    MemFree(temp);
+    HullMemFree(temp->data);
+    HullMemFree(temp);
   }
   list->head = NULL;
   list->tail = NULL;
@@ -0,0 +1,17 @@
+#include "dynamic_array.h"
+#include "hull_core.h"
+
+void *DArrayReserve(void *array, int *capacity, int required, size_t elementSize)
+{
+  if (required <= *capacity)
+  {
+    return array;
+  }
+  int newCapacity = *capacity > 0 ? *capacity : 16;
+  while (newCapacity < required)
+  {
+    newCapacity *= 2;
+  }
+  *capacity = newCapacity;
+  return HullMemRealloc(array, newCapacity * elementSize);
+}
@@ -0,0 +1,9 @@
+#ifndef DYNAMIC_ARRAY_H_
+#define DYNAMIC_ARRAY_H_
+#include "stddef.h"
+
+// Makes room for at least `required` elements, growing the capacity geometrically.
+// Returns the (possibly moved) array and updates `capacity`.
+void *DArrayReserve(void *array, int *capacity, int required, size_t elementSize);
+
+#endif
@@ -1,4 +1,5 @@
 #include "gui_control.h"
+#include "point_cloud.h"
 
 
 GuiControlLayoutState InitGuiControlState() {
@@ -16,6 +17,15 @@ GuiControlLayoutState InitGuiControlState() {
   state.stepSubmitted = false;
   state.nextStepPressed = false;
   state.prevStepPressed = false;
+  state.building = false;
+  state.resultStale = false;
+  state.buildProgress = 0.0f;
+  state.pointCount = 20;
+  state.pointCountEditMode = false;
+  state.pointCountSubmitted = false;
+  state.distribution = 0;
+  state.distributionChanged = false;
+  state.showPerfOverlay = true;
   
   // Bounding GroupBox
   state.layoutRecs[0] = (Rectangle){600, 20, 180, 400};
@@ -40,6 +50,20 @@ GuiControlLayoutState InitGuiControlState() {
   // Prev | Next Buttons
   state.layoutRecs[9] = (Rectangle){610, 220, 70, 20};
   state.layoutRecs[10] = (Rectangle){690, 220, 70, 20};
+  // Build Progress Bar
+  state.layoutRecs[12] = (Rectangle){610, 250, 150, 20};
+  // Build Status Label
+  state.layoutRecs[13] = (Rectangle){610, 275, 150, 20};
+  // Point Count Label
+  state.layoutRecs[14] = (Rectangle){610, 300, 100, 20};
+  // Point Count ValueBox
+  state.layoutRecs[15] = (Rectangle){610, 320, 150, 20};
+  // Distribution Label
+  state.layoutRecs[16] = (Rectangle){610, 345, 100, 20};
+  // Distribution ComboBox
+  state.layoutRecs[17] = (Rectangle){610, 365, 150, 20};
+  // Performance Overlay CheckBox
+  state.layoutRecs[18] = (Rectangle){610, 392, 20, 20};
   return state;
 }
 
@@ -61,4 +85,25 @@ void GuiControlLayout(GuiControlLayoutState* state){
   state->prevStepPressed = GuiButton(state->layoutRecs[9], "Prev");
   state->nextStepPressed = GuiButton(state->layoutRecs[10], "Next");
   state->clearPressed = GuiButton(state->layoutRecs[11], "Clear");
+  GuiLabel(state->layoutRecs[14], "Points");
+  // Submitted when leaving edit mode
+  state->pointCountSubmitted = false;
+  if (GuiValueBox(state->layoutRecs[15], NULL, &state->pointCount, 4, MAX_POINT_CLOUD_COUNT, state->pointCountEditMode)){
+    state->pointCountEditMode = !state->pointCountEditMode;
+    state->pointCountSubmitted = !state->pointCountEditMode;
+  }
+  GuiLabel(state->layoutRecs[16], "Distribution");
+  int previousDistribution = state->distribution;
+  // NOTE: Same order as PointDistribution
+  GuiComboBox(state->layoutRecs[17], "Cube;Ball;Sphere;Gaussian;Clustered;Coplanar;Collinear", &state->distribution);
+  state->distributionChanged = state->distribution != previousDistribution;
+  GuiCheckBox(state->layoutRecs[18], "Performance", &state->showPerfOverlay);
+  GuiProgressBar(state->layoutRecs[12], NULL, NULL, &state->buildProgress, 0.0f, 1.0f);
+  if (state->resultStale){
+    GuiLabel(state->layoutRecs[13], "Building... (result is stale)");
+  } else if (state->building){
+    GuiLabel(state->layoutRecs[13], "Building...");
+  } else {
+    GuiLabel(state->layoutRecs[13], "Result is up to date");
+  }
 }
\ No newline at end of file
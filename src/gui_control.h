@@ -3,7 +3,7 @@
 #include "raygui.h"
 #include "string.h"
 
-#define MAX_LAYOUT_RECS 16
+#define MAX_LAYOUT_RECS 32
 
 typedef struct GuiControlLayoutState {
   bool seedEditMode;
@@ -18,6 +18,15 @@ typedef struct GuiControlLayoutState {
   bool stepSubmitted;
   bool nextStepPressed;
   bool prevStepPressed;
+  bool building;        // A hull for the current vertices is still being built
+  bool resultStale;     // The shown hull belongs to older vertices
+  float buildProgress;  // 0 to 1
+  int pointCount;
+  bool pointCountEditMode;
+  bool pointCountSubmitted;
+  int distribution;     // PointDistribution
+  bool distributionChanged;
+  bool showPerfOverlay;
   Rectangle layoutRecs[MAX_LAYOUT_RECS];
 } GuiControlLayoutState;
 
@@ -0,0 +1,1041 @@
+#include "hull_build.h"
+#include "dynamic_array.h"
+#include "hull_order.h"
+#include "hull_time.h"
+#include "hull_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Triangle with input indices, as the history and snapshots hold them
+static ConvexShapeTriangle fInputTriangle(const HullBuild *build, int a, int b, int c)
+{
+  if (build->order)
+  {
+    return (ConvexShapeTriangle){ { build->order[a], build->order[b], build->order[c] } };
+  }
+  return (ConvexShapeTriangle){ { a, b, c } };
+}
+
+static int fInputIndex(const HullBuild *build, int i)
+{
+  return build->order ? build->order[i] : i;
+}
+
+//----------------------------------------------------------------------------------
+// Engine helpers shared by every scalar
+//----------------------------------------------------------------------------------
+
+// Triangle as stored in the build list, the id is only assigned when a history is recorded
+// NOTE: triangle must stay the first member, DListToArray copies only sizeof(ConvexShapeTriangle)
+typedef struct HullFace {
+  ConvexShapeTriangle triangle;
+  int id;
+  union {
+    HullOrientPlane plane;   // Decides most visibility tests without rebuilding the normal
+    HullGridPlane gridPlane; // Quantised builds
+  };
+} HullFace;
+
+// Face of the incremental engine without its plane, each scalar sets the plane
+static HullFace *fAllocHullFace(HullBuild *build, int a, int b, int c)
+{
+  HullFace *face = HullMemAlloc(sizeof(HullFace));
+  face->triangle.indices[0] = a;
+  face->triangle.indices[1] = b;
+  face->triangle.indices[2] = c;
+  face->id = build->history ? HullHistoryAddFace(build->history, fInputTriangle(build, a, b, c)) : -1;
+  return face;
+}
+
+static ConvexShapeEdge * fNewConvexShapeEdge(int a, int b){
+  ConvexShapeEdge *edge = HullMemAlloc(sizeof(ConvexShapeEdge));
+  edge->indices[0] = a;
+  edge->indices[1] = b;
+  return edge;
+}
+
+// Edges are compared by index, distinct vertices at almost the same position must not cancel each other
+static bool fSameEdge(ConvexShapeEdge *a, ConvexShapeEdge *b)
+{
+  return (a->indices[0] == b->indices[0] && a->indices[1] == b->indices[1])
+    || (a->indices[0] == b->indices[1] && a->indices[1] == b->indices[0]);
+}
+
+static void fTryAddHorizonEdgeIfUnique(DoublyLinkedList *horizon, ConvexShapeEdge* edgeToAdd)
+{
+  // Check if an edge is shared by two triangles
+  DNode *current = horizon->head;
+  while (current)
+  {
+    ConvexShapeEdge *currentEdge = (ConvexShapeEdge *)current->data;
+    if (fSameEdge(currentEdge, edgeToAdd))
+    {
+      DListRemoveNode(horizon, current); // Edge is shared, remove from horizon
+      HullMemFree(edgeToAdd);
+      return;
+    }
+    current = current->next;
+  }
+
+  // Otherwise, add it to the horizon
+  DListPushBack(horizon, (void *)edgeToAdd); // edgeToAdd is already allocated
+}
+
+#if HULL_STATS_ENABLED
+static int fHorizonBucket(int horizonCount)
+{
+  int bucket = 0;
+  while (horizonCount > 1 && bucket < HULL_STATS_HORIZON_BUCKETS - 1)
+  {
+    horizonCount >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+// Visible region and horizon of one insertion
+static void fRecordInsertion(HullBuildStats *stats, int visibleCount, int horizonCount)
+{
+  stats->insertions++;
+  if (visibleCount == 0)
+  {
+    return;
+  }
+  stats->visibleFaces += visibleCount;
+  if (visibleCount > stats->maxVisibleFaces) stats->maxVisibleFaces = visibleCount;
+  stats->horizonEdges += horizonCount;
+  stats->horizonHistogram[fHorizonBucket(horizonCount)]++;
+}
+
+static void fRecordLiveFaces(HullBuildStats *stats)
+{
+  long long live = stats->facesCreated - stats->facesDestroyed;
+  if (live > stats->peakLiveFaces) stats->peakLiveFaces = live;
+}
+#endif
+
+// Face of the conflict engine without its plane, each scalar sets the plane
+static int fAllocBuildFace(HullBuild *build, int a, int b, int c)
+{
+  int faceIndex;
+  if (build->freeFace >= 0)
+  {
+    faceIndex = build->freeFace;
+    build->freeFace = build->faces[faceIndex].conflictHead;
+  }
+  else
+  {
+    build->faces = DArrayReserve(build->faces, &build->faceCapacity, build->faceCount + 1, sizeof(HullBuildFace));
+    faceIndex = build->faceCount++;
+  }
+
+  HullBuildFace *face = &build->faces[faceIndex];
+  *face = (HullBuildFace){
+    .indices = { a, b, c },
+    .neighbors = { -1, -1, -1 },
+    .conflictHead = -1,
+    .historyId = -1,
+    .visitMark = -1,
+    .visible = false,
+    .alive = true
+  };
+  if (build->history)
+  {
+    face->historyId = HullHistoryAddFace(build->history, fInputTriangle(build, a, b, c));
+  }
+  build->liveFaceCount++;
+  HULL_STAT(build->stats.facesCreated++);
+  return faceIndex;
+}
+
+static void fDestroyBuildFace(HullBuild *build, int faceIndex)
+{
+  HullBuildFace *face = &build->faces[faceIndex];
+  if (build->history)
+  {
+    HullHistoryRemoveFace(build->history, face->historyId);
+  }
+  face->alive = false;
+  face->conflictHead = build->freeFace;
+  build->freeFace = faceIndex;
+  build->liveFaceCount--;
+  HULL_STAT(build->stats.facesDestroyed++);
+}
+
+static void fAddConflict(HullBuild *build, int faceIndex, int point)
+{
+  build->pointFace[point] = faceIndex;
+  build->pointNext[point] = build->faces[faceIndex].conflictHead;
+  build->faces[faceIndex].conflictHead = point;
+}
+
+static bool fInSimplex(const HullBuild *build, int vertex)
+{
+  return vertex == build->simplex[0] || vertex == build->simplex[1] || vertex == build->simplex[2] || vertex == build->simplex[3];
+}
+
+// Links every edge of the tetrahedron to the face holding the reversed edge
+static void fLinkTetrahedron(HullBuild *build, const int faces[4])
+{
+  for (int i = 0; i < 4; i++)
+  {
+    HullBuildFace *face = &build->faces[faces[i]];
+    for (int k = 0; k < 3; k++)
+    {
+      int a = face->indices[k];
+      int b = face->indices[(k + 1) % 3];
+      for (int j = 0; j < 4; j++)
+      {
+        HullBuildFace *other = &build->faces[faces[j]];
+        for (int e = 0; e < 3; e++)
+        {
+          if (other->indices[e] == b && other->indices[(e + 1) % 3] == a)
+          {
+            face->neighbors[k] = faces[j];
+          }
+        }
+      }
+    }
+  }
+}
+
+// Every point but the simplex into pendingPoints, returns their count
+static int fPendingOutsideSimplex(HullBuild *build)
+{
+  int pendingCount = 0;
+  build->pendingPoints = DArrayReserve(build->pendingPoints, &build->pendingCapacity, build->vertexCount, sizeof(int));
+  for (int i = 0; i < build->vertexCount; i++)
+  {
+    if (fInSimplex(build, i))
+    {
+      build->pointFace[i] = -1;
+      continue;
+    }
+    build->pendingPoints[pendingCount++] = i;
+  }
+  return pendingCount;
+}
+
+// Collects the horizon of the visible faces into horizonEdges and their outside points into pendingPoints,
+// then destroys the faces. Returns the number of horizon edges.
+static int fRemoveVisible(HullBuild *build, int visibleCount, int newVertexIndex, int *pendingCount)
+{
+  // The horizon is every edge between a visible and a hidden face,
+  // the outside points of the visible faces have to be reassigned
+  int mark = build->step;
+  int horizonCount = 0;
+  *pendingCount = 0;
+  for (int v = 0; v < visibleCount; v++)
+  {
+    HullBuildFace *face = &build->faces[build->visibleFaces[v]];
+    for (int k = 0; k < 3; k++)
+    {
+      int neighbor = face->neighbors[k];
+      if (neighbor >= 0 && build->faces[neighbor].visitMark == mark && build->faces[neighbor].visible)
+      {
+        continue;
+      }
+      build->horizonEdges = DArrayReserve(build->horizonEdges, &build->horizonCapacity, (horizonCount + 1) * 3, sizeof(int));
+      build->horizonEdges[horizonCount * 3 + 0] = face->indices[k];
+      build->horizonEdges[horizonCount * 3 + 1] = face->indices[(k + 1) % 3];
+      build->horizonEdges[horizonCount * 3 + 2] = neighbor;
+      horizonCount++;
+    }
+    for (int point = face->conflictHead; point >= 0; point = build->pointNext[point])
+    {
+      if (point == newVertexIndex)
+      {
+        continue;
+      }
+      build->pendingPoints = DArrayReserve(build->pendingPoints, &build->pendingCapacity, *pendingCount + 1, sizeof(int));
+      build->pendingPoints[(*pendingCount)++] = point;
+    }
+  }
+
+  HULL_STAT(fRecordInsertion(&build->stats, visibleCount, horizonCount));
+  for (int v = 0; v < visibleCount; v++)
+  {
+    fDestroyBuildFace(build, build->visibleFaces[v]);
+  }
+  return horizonCount;
+}
+
+// Links the cone of new faces, newFaces[e] over horizon edge e, to the faces beyond the horizon and to each other
+static void fLinkCone(HullBuild *build, int horizonCount)
+{
+  for (int e = 0; e < horizonCount; e++)
+  {
+    int a = build->horizonEdges[e * 3 + 0];
+    int b = build->horizonEdges[e * 3 + 1];
+    int beyond = build->horizonEdges[e * 3 + 2];
+    int faceIndex = build->newFaces[e];
+    build->faces[faceIndex].neighbors[0] = beyond;
+    if (beyond >= 0)
+    {
+      HullBuildFace *other = &build->faces[beyond];
+      for (int k = 0; k < 3; k++)
+      {
+        if (other->indices[k] == b && other->indices[(k + 1) % 3] == a)
+        {
+          other->neighbors[k] = faceIndex;
+        }
+      }
+    }
+    build->horizonStart[a] = faceIndex;
+  }
+  // Face (a, b, p) meets the face starting at b across (b, p), which meets it back across (p, b)
+  for (int e = 0; e < horizonCount; e++)
+  {
+    int faceIndex = build->newFaces[e];
+    int next = build->horizonStart[build->faces[faceIndex].indices[1]];
+    build->faces[faceIndex].neighbors[1] = next;
+    if (next >= 0)
+    {
+      build->faces[next].neighbors[2] = faceIndex;
+    }
+  }
+  for (int e = 0; e < horizonCount; e++)
+  {
+    build->horizonStart[build->horizonEdges[e * 3 + 0]] = -1;
+  }
+}
+
+//----------------------------------------------------------------------------------
+// Engines per scalar, generated from hull_build_template.h
+//----------------------------------------------------------------------------------
+
+// HULL_SCALAR_FLOAT: plane filter, then the exact predicates
+#define HULL_B_FN(op) op##Float
+#define HULL_B_V HullVec3
+#define HULL_B_POINTS vertices
+#define HULL_B_PLANE plane
+#define HULL_B_PLANE_T HullOrientPlane
+#define HULL_B_PLANE_INIT(plane, build, a, b, c) HullOrientPlaneInit(plane, (build)->vertices[a], (build)->vertices[b], (build)->vertices[c], (build)->extent)
+#define HULL_B_DET_T double
+#define HULL_B_DECIDE(plane, p, det) HullOrientPlaneFilter(plane, p, &(det))
+#define HULL_B_SOS HullOrient3dSoS
+#include "hull_build_template.h"
+
+// HULL_SCALAR_DOUBLE: the same on double points, with the wider bound of double differences
+#define HULL_B_FN(op) op##Double
+#define HULL_B_V HullVec3d
+#define HULL_B_POINTS precise
+#define HULL_B_PLANE plane
+#define HULL_B_PLANE_T HullOrientPlane
+#define HULL_B_PLANE_INIT(plane, build, a, b, c) HullOrientPlaneInitDouble(plane, (build)->precise[a], (build)->precise[b], (build)->precise[c], (build)->preciseExtent)
+#define HULL_B_DET_T double
+#define HULL_B_DECIDE(plane, p, det) HullOrientPlaneFilterDouble(plane, p, &(det))
+#define HULL_B_SOS HullOrient3dSoSDouble
+#include "hull_build_template.h"
+
+// HULL_SCALAR_GRID_NARROW: exact 64 bit determinants, only zero goes to the tie break
+#define HULL_B_FN(op) op##GridNarrow
+#define HULL_B_V HullVec3i
+#define HULL_B_POINTS grid
+#define HULL_B_PLANE gridPlane
+#define HULL_B_PLANE_T HullGridPlane
+#define HULL_B_PLANE_INIT(plane, build, a, b, c) HullGridPlaneInit(plane, (build)->grid[a], (build)->grid[b], (build)->grid[c])
+#define HULL_B_DET_T int64_t
+#define HULL_B_DECIDE(plane, p, det) (((det) = HullGridPlaneDetNarrow(plane, p)) != 0)
+#define HULL_B_SOS HullOrient3dGridSoS
+#include "hull_build_template.h"
+
+// HULL_SCALAR_GRID: the same with HullGridDet determinants
+#define HULL_B_FN(op) op##Grid
+#define HULL_B_V HullVec3i
+#define HULL_B_POINTS grid
+#define HULL_B_PLANE gridPlane
+#define HULL_B_PLANE_T HullGridPlane
+#define HULL_B_PLANE_INIT(plane, build, a, b, c) HullGridPlaneInit(plane, (build)->grid[a], (build)->grid[b], (build)->grid[c])
+#define HULL_B_DET_T HullGridDet
+#define HULL_B_DECIDE(plane, p, det) (((det) = HullGridPlaneDet(plane, p)) != 0)
+#define HULL_B_SOS HullOrient3dGridSoS
+#include "hull_build_template.h"
+
+typedef struct HullEngineFunctions {
+  void (*tetrahedron)(HullBuild *build, int tetrahedron[4][3]);
+  void (*insert)(HullBuild *build, int newVertexIndex);
+} HullEngineFunctions;
+
+// Picked once per step, the tests inside an insertion never branch on the scalar
+static const HullEngineFunctions engineFunctions[HULL_SCALAR_COUNT][HULL_ENGINE_COUNT] = {
+  [HULL_SCALAR_FLOAT] = {
+    [HULL_ENGINE_INCREMENTAL] = { fIncrementalTetrahedronFloat, fIncrementalInsertFloat },
+    [HULL_ENGINE_CONFLICT] = { fConflictTetrahedronFloat, fConflictInsertFloat }
+  },
+  [HULL_SCALAR_DOUBLE] = {
+    [HULL_ENGINE_INCREMENTAL] = { fIncrementalTetrahedronDouble, fIncrementalInsertDouble },
+    [HULL_ENGINE_CONFLICT] = { fConflictTetrahedronDouble, fConflictInsertDouble }
+  },
+  [HULL_SCALAR_GRID_NARROW] = {
+    [HULL_ENGINE_INCREMENTAL] = { fIncrementalTetrahedronGridNarrow, fIncrementalInsertGridNarrow },
+    [HULL_ENGINE_CONFLICT] = { fConflictTetrahedronGridNarrow, fConflictInsertGridNarrow }
+  },
+  [HULL_SCALAR_GRID] = {
+    [HULL_ENGINE_INCREMENTAL] = { fIncrementalTetrahedronGrid, fIncrementalInsertGrid },
+    [HULL_ENGINE_CONFLICT] = { fConflictTetrahedronGrid, fConflictInsertGrid }
+  }
+};
+
+//----------------------------------------------------------------------------------
+// Shared stepping
+//----------------------------------------------------------------------------------
+
+// Coordinates the build decides on, the grid or double ones when it has them. All are exact in double.
+static HullVec3d fExactPoint(const HullBuild *build, int i)
+{
+  if (build->grid)
+  {
+    return (HullVec3d){ build->grid[i].x, build->grid[i].y, build->grid[i].z };
+  }
+  if (build->precise)
+  {
+    return build->precise[i];
+  }
+  return HullVec3ToDouble(build->vertices[i]);
+}
+
+// Exactly on one line, seen in all three axis projections
+static bool fCollinear(const HullBuild *build, int a, int b, int c)
+{
+  HullVec3d p = fExactPoint(build, a), q = fExactPoint(build, b), r = fExactPoint(build, c);
+  return HullOrient2d(p.x, p.y, q.x, q.y, r.x, r.y) == 0
+    && HullOrient2d(p.y, p.z, q.y, q.z, r.y, r.z) == 0
+    && HullOrient2d(p.z, p.x, q.z, q.x, r.z, r.x) == 0;
+}
+
+static double fOrient(const HullBuild *build, int a, int b, int c, int d)
+{
+  HullVec3 *vertices = build->vertices;
+  HullVec3i *grid = build->grid;
+  HullVec3d *precise = build->precise;
+  if (grid) return HullOrient3dGrid(grid[a], grid[b], grid[c], grid[d]);
+  if (precise) return HullOrient3dDouble(precise[a], precise[b], precise[c], precise[d]);
+  return HullOrient3d(vertices[a], vertices[b], vertices[c], vertices[d]);
+}
+
+// One pass over the input: the first point, the first one apart from it, the first one off their line and the
+// first one off their plane. Every point skipped on the way lies on what was found so far, so nothing is missed.
+// Returns how many were found, fewer than 4 for flat input.
+static int fFindSimplex(HullBuild *build)
+{
+  int *simplex = build->simplex;
+  int found = 1;
+  simplex[0] = 0;
+  for (int i = 1; i < build->vertexCount && found < 4; i++)
+  {
+    if (found == 1)
+    {
+      HullVec3d a = fExactPoint(build, simplex[0]), p = fExactPoint(build, i);
+      if (a.x != p.x || a.y != p.y || a.z != p.z) simplex[found++] = i;
+    }
+    else if (found == 2)
+    {
+      if (!fCollinear(build, simplex[0], simplex[1], i)) simplex[found++] = i;
+    }
+    else if (fOrient(build, simplex[0], simplex[1], simplex[2], i) != 0)
+    {
+      simplex[found++] = i;
+    }
+  }
+  return found;
+}
+
+// Faces of the tetrahedron over the simplex, oriented outwards
+static void fTetrahedronFaces(const HullBuild *build, int tetrahedron[4][3])
+{
+  int a = build->simplex[0], b = build->simplex[1], c = build->simplex[2], d = build->simplex[3];
+  if (fOrient(build, a, b, c, d) < 0)
+  {
+    // When D is behind the ABC plane
+    int faces[4][3] = { { a, b, c }, { a, c, d }, { a, d, b }, { b, d, c } }; // ABC, ACD, ADB, BDC
+    memcpy(tetrahedron, faces, sizeof(faces));
+  }
+  else
+  {
+    // When D is in front of the ABC plane
+    int faces[4][3] = { { a, c, b }, { a, d, c }, { a, b, d }, { b, c, d } }; // ACB, ADC, ABD, BCD
+    memcpy(tetrahedron, faces, sizeof(faces));
+  }
+}
+
+// Projected point of a flat input
+typedef struct HullFlatPoint {
+  double u;
+  double v;
+  int index;
+} HullFlatPoint;
+
+static int fCompareFlatPoints(const void *a, const void *b)
+{
+  const HullFlatPoint *p = a, *q = b;
+  if (p->u != q->u) return p->u < q->u ? -1 : 1;
+  if (p->v != q->v) return p->v < q->v ? -1 : 1;
+  return (p->index > q->index) - (p->index < q->index);
+}
+
+// Collinear input: the two ends, found along the axis the line advances most on
+static void fFlatSegment(HullBuild *build)
+{
+  HullVec3d a = fExactPoint(build, build->simplex[0]), b = fExactPoint(build, build->simplex[1]);
+  double direction[3] = { fabs(b.x - a.x), fabs(b.y - a.y), fabs(b.z - a.z) };
+  int axis = direction[0] >= direction[1] && direction[0] >= direction[2] ? 0 : direction[1] >= direction[2] ? 1 : 2;
+  int low = 0, high = 0;
+  double lowValue = INFINITY, highValue = -INFINITY;
+  for (int i = 0; i < build->vertexCount; i++)
+  {
+    HullVec3d p = fExactPoint(build, i);
+    double value = axis == 0 ? p.x : axis == 1 ? p.y : p.z;
+    if (value < lowValue)
+    {
+      low = i;
+      lowValue = value;
+    }
+    if (value > highValue)
+    {
+      high = i;
+      highValue = value;
+    }
+  }
+  build->flatHull = HullMemAlloc(sizeof(int) * 2);
+  build->flatHull[0] = low;
+  build->flatHull[1] = high;
+  build->flatCount = 2;
+}
+
+// Coplanar input: Andrew's monotone chain in O(n log n) on the points projected along an axis the plane is not
+// parallel to, with exact turns. Points on an edge or on another point are dropped. The corners run
+// counter-clockwise seen from the positive side of that axis.
+static void fFlatPolygon(HullBuild *build)
+{
+  int a = build->simplex[0], b = build->simplex[1], c = build->simplex[2];
+  HullVec3d pa = fExactPoint(build, a);
+  HullVec3d normal = HullVec3dCrossProduct(HullVec3dSubtract(fExactPoint(build, b), pa), HullVec3dSubtract(fExactPoint(build, c), pa));
+  double weight[3] = { fabs(normal.x), fabs(normal.y), fabs(normal.z) };
+
+  // Largest normal component first, but the rounded normal can be wrong when a, b and c are almost on a line,
+  // so the projection is checked to keep them apart
+  int axes[3] = { 0, 1, 2 };
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = i + 1; j < 3; j++)
+    {
+      if (weight[axes[j]] > weight[axes[i]])
+      {
+        int swap = axes[i];
+        axes[i] = axes[j];
+        axes[j] = swap;
+      }
+    }
+  }
+  double p[3][3];
+  for (int k = 0; k < 3; k++)
+  {
+    HullVec3d point = fExactPoint(build, build->simplex[k]);
+    p[k][0] = point.x;
+    p[k][1] = point.y;
+    p[k][2] = point.z;
+  }
+  int axis = axes[0];
+  for (int i = 0; i < 3; i++)
+  {
+    int u = (axes[i] + 1) % 3, v = (axes[i] + 2) % 3;
+    if (HullOrient2d(p[0][u], p[0][v], p[1][u], p[1][v], p[2][u], p[2][v]) != 0)
+    {
+      axis = axes[i];
+      break;
+    }
+  }
+
+  int n = build->vertexCount;
+  HullFlatPoint *points = HullMemAlloc(sizeof(HullFlatPoint) * (size_t)n);
+  for (int i = 0; i < n; i++)
+  {
+    HullVec3d p = fExactPoint(build, i);
+    double coordinates[3] = { p.x, p.y, p.z };
+    points[i] = (HullFlatPoint){ coordinates[(axis + 1) % 3], coordinates[(axis + 2) % 3], i };
+  }
+  qsort(points, n, sizeof(HullFlatPoint), fCompareFlatPoints);
+
+  // Lower chain left to right, then the upper one back, each keeps only strict left turns
+  int *chain = HullMemAlloc(sizeof(int) * (size_t)(2 * n));
+  int count = 0;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    int base = count;
+    for (int k = 0; k < n; k++)
+    {
+      const HullFlatPoint *p = &points[pass == 0 ? k : n - 1 - k];
+      while (count >= base + 2)
+      {
+        const HullFlatPoint *q = &points[chain[count - 2]], *r = &points[chain[count - 1]];
+        if (HullOrient2d(q->u, q->v, r->u, r->v, p->u, p->v) > 0) break;
+        count--;
+      }
+      chain[count++] = (int)(p - points);
+    }
+    // The last point of each chain starts the other one
+    count--;
+  }
+  for (int i = 0; i < count; i++) chain[i] = points[chain[i]].index;
+  HullMemFree(points);
+  build->flatHull = chain;
+  build->flatCount = count;
+}
+
+// A segment, or the polygon as a fan from its first corner and, reversed, a fan from its second one.
+// Different diagonals on the two sides keep every edge between exactly two triangles.
+static void fFlatSnapshot(const HullBuild *build, ConvexShape *shape)
+{
+  const int *corners = build->flatHull;
+  int k = build->flatCount;
+  if (k == 2)
+  {
+    shape->edgeCount = 1;
+    shape->edges = HullMemAlloc(sizeof(ConvexShapeEdge));
+    shape->edges[0] = (ConvexShapeEdge){ { corners[0], corners[1] } };
+    return;
+  }
+  shape->triangles = HullMemAlloc(sizeof(ConvexShapeTriangle) * (size_t)(2 * (k - 2)));
+  for (int i = 1; i + 1 < k; i++)
+  {
+    shape->triangles[shape->triangleCount++] = (ConvexShapeTriangle){ { corners[0], corners[i], corners[i + 1] } };
+  }
+  for (int i = 2; i < k; i++)
+  {
+    shape->triangles[shape->triangleCount++] = (ConvexShapeTriangle){ { corners[1], corners[(i + 1) % k], corners[i] } };
+  }
+}
+
+// Runs the first step on flat input, the hull is complete after it
+static void fFlatHull(HullBuild *build, int found)
+{
+  if (found == 2)
+  {
+    fFlatSegment(build);
+  }
+  else
+  {
+    fFlatPolygon(build);
+  }
+  if (build->history)
+  {
+    HullHistoryBeginStep(build->history);
+    ConvexShape shape = { 0 };
+    fFlatSnapshot(build, &shape);
+    for (int i = 0; i < shape.triangleCount; i++)
+    {
+      const int *t = shape.triangles[i].indices;
+      HullHistoryAddFace(build->history, fInputTriangle(build, t[0], t[1], t[2]));
+    }
+    if (shape.edgeCount > 0)
+    {
+      const int *e = shape.edges[0].indices;
+      HullHistorySetSegment(build->history, (ConvexShapeEdge){ { fInputIndex(build, e[0]), fInputIndex(build, e[1]) } });
+    }
+    HullMemFree(shape.triangles);
+    HullMemFree(shape.edges);
+  }
+}
+
+static void fSkipSimplexVertices(HullBuild *build)
+{
+  while (build->nextVertex < build->vertexCount && fInSimplex(build, build->nextVertex))
+  {
+    build->nextVertex++;
+  }
+  build->finished = build->nextVertex >= build->vertexCount;
+}
+
+static void fBuildStep(HullBuild *build)
+{
+  if (build->step == 0)
+  {
+    int found = fFindSimplex(build);
+    if (found < 2)
+    {
+      build->degenerate = true;
+      build->finished = true;
+      return;
+    }
+    if (found < 4)
+    {
+      build->step = 1;
+      fFlatHull(build, found);
+      build->finished = true;
+      return;
+    }
+    int tetrahedron[4][3];
+    fTetrahedronFaces(build, tetrahedron);
+    if (build->history)
+    {
+      HullHistoryBeginStep(build->history);
+    }
+    engineFunctions[build->scalar][build->engine].tetrahedron(build, tetrahedron);
+    HULL_STAT(fRecordLiveFaces(&build->stats));
+    build->step = 1;
+    fSkipSimplexVertices(build);
+    return;
+  }
+
+  if (build->history)
+  {
+    HullHistoryBeginStep(build->history);
+  }
+  build->step++;
+  engineFunctions[build->scalar][build->engine].insert(build, build->nextVertex);
+  HULL_STAT(fRecordLiveFaces(&build->stats));
+  build->nextVertex++;
+  fSkipSimplexVertices(build);
+}
+
+static const char *phaseNames[HULL_PHASE_COUNT] = { "prefilter", "initialSimplex", "insertion", "output" };
+
+// Point in time of a phase boundary, counters are only read when the build has perf
+typedef struct HullPhaseMark {
+  double time;
+  HullPerfSample counters;
+} HullPhaseMark;
+
+static void fPhaseMark(HullPerf *perf, HullPhaseMark *mark)
+{
+  if (perf)
+  {
+    HullPerfRead(perf, &mark->counters);
+  }
+  mark->time = HullTimeNow();
+}
+
+// Adds the time since *mark to the phase and moves the mark to now
+static void fPhaseEnd(HullBuild *build, HullPhase phase, HullPhaseMark *mark)
+{
+  HullPhaseMark now;
+  now.time = HullTimeNow();
+  build->phaseSeconds[phase] += now.time - mark->time;
+  HullTraceComplete(phaseNames[phase], mark->time, now.time);
+  if (build->perf)
+  {
+    HullPerfRead(build->perf, &now.counters);
+    HullPerfAccumulate(&build->phaseCounters[phase], &mark->counters, &now.counters);
+  }
+  *mark = now;
+}
+
+HullBuild *HullBuildBegin(HullVec3 v[], int n, HullEngine engine)
+{
+  return HullBuildBeginEx(v, n, engine, NULL);
+}
+
+// Snaps the build's vertices to the grid, false when a coordinate is off the representable range
+static bool fQuantize(HullBuild *build, float gridStep)
+{
+  int n = build->vertexCount;
+  build->grid = HullMemAlloc(sizeof(HullVec3i) * (n > 0 ? n : 1));
+  build->gridStep = gridStep;
+  bool narrow = true;
+  for (int i = 0; i < n; i++)
+  {
+    float in[3] = { build->vertices[i].x, build->vertices[i].y, build->vertices[i].z };
+    int32_t out[3];
+    for (int k = 0; k < 3; k++)
+    {
+      double steps = nearbyint(in[k] / (double)gridStep);
+      // Also rejects NaN
+      if (!(fabs(steps) <= HULL_GRID_MAX))
+      {
+        return false;
+      }
+      out[k] = (int32_t)steps;
+      narrow &= fabs(steps) <= HULL_GRID_NARROW_MAX;
+    }
+    build->grid[i] = (HullVec3i){ out[0], out[1], out[2] };
+    // The output holds the snapped points, so the hull is exact for what is drawn or written
+    build->vertices[i] = (HullVec3){ (float)(out[0] * (double)gridStep), (float)(out[1] * (double)gridStep), (float)(out[2] * (double)gridStep) };
+  }
+  build->scalar = narrow ? HULL_SCALAR_GRID_NARROW : HULL_SCALAR_GRID;
+  return true;
+}
+
+// Keeps the double points and rounds them to float for the output, false when a coordinate is off the range
+// the double predicates are exact for
+static bool fKeepPrecise(HullBuild *build, const HullVec3d v[])
+{
+  int n = build->vertexCount;
+  build->precise = HullMemAlloc(sizeof(HullVec3d) * (n > 0 ? n : 1));
+  memcpy(build->precise, v, sizeof(HullVec3d) * n);
+  double high = ldexp(1.0, HULL_DOUBLE_MAX_EXPONENT), low = ldexp(1.0, -HULL_DOUBLE_MAX_EXPONENT);
+  for (int i = 0; i < n; i++)
+  {
+    double in[3] = { v[i].x, v[i].y, v[i].z };
+    for (int k = 0; k < 3; k++)
+    {
+      // Also rejects NaN
+      if (in[k] != 0.0 && !(fabs(in[k]) >= low && fabs(in[k]) <= high))
+      {
+        return false;
+      }
+    }
+    build->vertices[i] = (HullVec3){ (float)in[0], (float)in[1], (float)in[2] };
+  }
+  build->preciseExtent = HullOrientExtentDouble(build->precise, n);
+  build->scalar = HULL_SCALAR_DOUBLE;
+  return true;
+}
+
+// v or, for double builds, precise holds the points
+static HullBuild *fBuildBegin(HullVec3 v[], const HullVec3d precise[], int n, HullEngine engine, HullPerf *perf, float gridStep)
+{
+  HullPhaseMark mark;
+  fPhaseMark(perf, &mark);
+  HullBuild *build = HullMemAlloc(sizeof(HullBuild));
+  *build = (HullBuild){0};
+  build->perf = perf;
+  for (int i = 0; i < HULL_PHASE_COUNT; i++)
+  {
+    HullPerfSampleClear(&build->phaseCounters[i]);
+  }
+  // Any other value has always meant the incremental engine
+  build->engine = engine == HULL_ENGINE_CONFLICT ? engine : HULL_ENGINE_INCREMENTAL;
+  build->vertexCount = n;
+  for (int k = 0; k < 4; k++)
+  {
+    build->simplex[k] = -1;
+  }
+  build->freeFace = -1;
+
+  // Object ownership, since ConvexShape also maintains an array of vertices
+  build->vertices = HullMemAlloc(sizeof(HullVec3) * (n > 0 ? n : 1));
+  if (precise && !fKeepPrecise(build, precise))
+  {
+    HullLog(HULL_LOG_ERROR, "HullBuildBeginDouble: coordinates must be 0 or of a magnitude within 2^-%d to 2^%d", HULL_DOUBLE_MAX_EXPONENT, HULL_DOUBLE_MAX_EXPONENT);
+    HullBuildEnd(build);
+    return NULL;
+  }
+  if (!precise)
+  {
+    memcpy(build->vertices, v, sizeof(HullVec3) * n);
+  }
+  if (gridStep > 0.0f && !fQuantize(build, gridStep))
+  {
+    HullLog(HULL_LOG_ERROR, "HullBuildBeginQuantized: coordinates further than %d steps of %g from the origin", HULL_GRID_MAX, gridStep);
+    HullBuildEnd(build);
+    return NULL;
+  }
+  build->extent = HullOrientExtent(build->vertices, n);
+
+  if (n < 2)
+  {
+    build->degenerate = true;
+    build->finished = true;
+    fPhaseEnd(build, HULL_PHASE_PREFILTER, &mark);
+    return build;
+  }
+
+  if (build->engine == HULL_ENGINE_CONFLICT)
+  {
+    build->pointFace = HullMemAlloc(sizeof(int) * n);
+    build->pointNext = HullMemAlloc(sizeof(int) * n);
+    build->horizonStart = HullMemAlloc(sizeof(int) * n);
+    for (int i = 0; i < n; i++)
+    {
+      build->pointFace[i] = -1;
+      build->horizonStart[i] = -1;
+    }
+  }
+  else
+  {
+    build->triangles = DListNew();
+  }
+  fPhaseEnd(build, HULL_PHASE_PREFILTER, &mark);
+  return build;
+}
+
+HullBuild *HullBuildBeginEx(HullVec3 v[], int n, HullEngine engine, HullPerf *perf)
+{
+  return fBuildBegin(v, NULL, n, engine, perf, 0.0f);
+}
+
+HullBuild *HullBuildBeginQuantized(HullVec3 v[], int n, float gridStep, HullEngine engine, HullPerf *perf)
+{
+  if (!(gridStep > 0.0f) || isinf(gridStep))
+  {
+    HullLog(HULL_LOG_ERROR, "HullBuildBeginQuantized: grid step must be positive and finite");
+    return NULL;
+  }
+  return fBuildBegin(v, NULL, n, engine, perf, gridStep);
+}
+
+HullBuild *HullBuildBeginDouble(HullVec3d v[], int n, HullEngine engine, HullPerf *perf)
+{
+  return fBuildBegin(NULL, v, n, engine, perf, 0.0f);
+}
+
+bool HullBuildSpatialOrder(HullBuild *build, int threadCount)
+{
+  if (build->step > 0)
+  {
+    return false;
+  }
+  if (build->order)
+  {
+    return true;
+  }
+  HullPhaseMark mark;
+  fPhaseMark(build->perf, &mark);
+  int n = build->vertexCount;
+  build->order = CreateHullSpatialOrder(build->vertices, n, threadCount);
+  HullVec3 *vertices = HullMemAlloc(sizeof(HullVec3) * (n > 0 ? n : 1));
+  for (int i = 0; i < n; i++) vertices[i] = build->vertices[build->order[i]];
+  HullMemFree(build->vertices);
+  build->vertices = vertices;
+  if (build->grid)
+  {
+    HullVec3i *grid = HullMemAlloc(sizeof(HullVec3i) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) grid[i] = build->grid[build->order[i]];
+    HullMemFree(build->grid);
+    build->grid = grid;
+  }
+  if (build->precise)
+  {
+    HullVec3d *precise = HullMemAlloc(sizeof(HullVec3d) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) precise[i] = build->precise[build->order[i]];
+    HullMemFree(build->precise);
+    build->precise = precise;
+  }
+  fPhaseEnd(build, HULL_PHASE_PREFILTER, &mark);
+  return true;
+}
+
+// Runs up to steps insertions (negative: all), stopping early once the clock passes a positive deadline.
+static int fRunSteps(HullBuild *build, int steps, double deadline)
+{
+  int done = 0;
+  HullPhaseMark mark;
+  fPhaseMark(build->perf, &mark);
+  if (build->step == 0 && !build->finished && steps != 0)
+  {
+    fBuildStep(build);
+    done++;
+    fPhaseEnd(build, HULL_PHASE_INITIAL_SIMPLEX, &mark);
+  }
+  while (!build->finished && (steps < 0 || done < steps))
+  {
+    fBuildStep(build);
+    done++;
+    // A single insertion can touch every outside point, so the clock is checked after each step
+    if (deadline > 0.0 && HullTimeNow() >= deadline)
+    {
+      break;
+    }
+  }
+  fPhaseEnd(build, HULL_PHASE_INSERTION, &mark);
+  return done;
+}
+
+int HullBuildStep(HullBuild *build, int steps)
+{
+  // Negative steps run the build to the end
+  return fRunSteps(build, steps, 0.0);
+}
+
+int HullBuildStepFor(HullBuild *build, double budgetMicros)
+{
+  return fRunSteps(build, -1, HullTimeNow() + budgetMicros * 1e-6);
+}
+
+// Puts a snapshot of a spatially ordered build back into input order
+static void fRestoreInputOrder(const HullBuild *build, ConvexShape *shape)
+{
+  for (int i = 0; i < build->vertexCount; i++)
+  {
+    shape->vertices[build->order[i]] = build->vertices[i];
+  }
+  for (int i = 0; i < shape->triangleCount; i++)
+  {
+    const int *t = shape->triangles[i].indices;
+    shape->triangles[i] = fInputTriangle(build, t[0], t[1], t[2]);
+  }
+  for (int i = 0; i < shape->edgeCount; i++)
+  {
+    for (int k = 0; k < 2; k++) shape->edges[i].indices[k] = build->order[shape->edges[i].indices[k]];
+  }
+}
+
+ConvexShape *HullBuildSnapshot(HullBuild *build)
+{
+  if (build->degenerate || build->step == 0)
+  {
+    return NULL;
+  }
+
+  HullPhaseMark mark;
+  fPhaseMark(build->perf, &mark);
+  ConvexShape *shape = (ConvexShape *)HullMemAlloc(sizeof(ConvexShape));
+  shape->vertexCount = build->vertexCount;
+  shape->vertices = HullMemAlloc(sizeof(HullVec3) * build->vertexCount);
+  memcpy(shape->vertices, build->vertices, sizeof(HullVec3) * build->vertexCount);
+
+  if (build->flatCount > 0)
+  {
+    fFlatSnapshot(build, shape);
+  }
+  else if (build->engine == HULL_ENGINE_CONFLICT)
+  {
+    shape->triangleCount = 0;
+    shape->triangles = HullMemAlloc(sizeof(ConvexShapeTriangle) * build->liveFaceCount);
+    for (int i = 0; i < build->faceCount; i++)
+    {
+      HullBuildFace *face = &build->faces[i];
+      if (face->alive)
+      {
+        shape->triangles[shape->triangleCount++] = (ConvexShapeTriangle){ { face->indices[0], face->indices[1], face->indices[2] } };
+      }
+    }
+  }
+  else
+  {
+    shape->triangles = DListToArray(build->triangles, sizeof(ConvexShapeTriangle), &shape->triangleCount);
+  }
+  if (build->order)
+  {
+    fRestoreInputOrder(build, shape);
+  }
+  fPhaseEnd(build, HULL_PHASE_OUTPUT, &mark);
+  return shape;
+}
+
+void HullBuildEnd(HullBuild *build)
+{
+  if (build == NULL)
+  {
+    return;
+  }
+  if (build->triangles)
+  {
+    DListClear(build->triangles);
+    HullMemFree(build->triangles);
+  }
+  HullMemFree(build->faces);
+  HullMemFree(build->pointFace);
+  HullMemFree(build->pointNext);
+  HullMemFree(build->horizonStart);
+  HullMemFree(build->visibleFaces);
+  HullMemFree(build->horizonEdges);
+  HullMemFree(build->newFaces);
+  HullMemFree(build->pendingPoints);
+  HullMemFree(build->vertices);
+  HullMemFree(build->order);
+  HullMemFree(build->grid);
+  HullMemFree(build->precise);
+  HullMemFree(build->flatHull);
+  HullMemFree(build);
+}
+
+const char *GetHullPhaseName(HullPhase phase)
+{
+  if (phase < 0 || phase >= HULL_PHASE_COUNT)
+  {
+    return "unknown";
+  }
+  return phaseNames[phase];
+}
@@ -0,0 +1,141 @@
+#ifndef HULL_BUILD_H_
+#define HULL_BUILD_H_
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "doubly_linked_list.h"
+#include "hull_history.h"
+#include "hull_perf.h"
+#include "hull_predicates.h"
+
+// Face of the conflict engine
+typedef struct HullBuildFace {
+  int indices[3];
+  union {
+    HullOrientPlane plane;    // Orientation filter through the three vertices, float and double builds
+    HullGridPlane gridPlane;  // Used instead when the build is quantised
+  };
+  int neighbors[3];  // Face across the edge (indices[k], indices[(k + 1) % 3])
+  int conflictHead;  // First outside point of this face, -1 when there is none
+  int historyId;
+  int visitMark;     // Step that last tested the face against the inserted point
+  bool visible;      // Valid when visitMark is the current step
+  bool alive;
+} HullBuildFace;
+
+// Algorithmic counters, only collected when the library is built with -DHULL_STATS.
+// The struct is always part of HullBuild so code built with and without the flag can be mixed.
+#if defined(HULL_STATS)
+  #define HULL_STATS_ENABLED 1
+  #define HULL_STAT(statement) statement
+#else
+  #define HULL_STATS_ENABLED 0
+  #define HULL_STAT(statement)
+#endif
+
+// Bucket k counts insertions whose horizon has [2^k, 2^(k+1)) edges
+#define HULL_STATS_HORIZON_BUCKETS 16
+
+typedef struct HullBuildStats {
+  long long canSeeTests;     // Point vs face orientation tests
+  long long insertions;      // Vertices processed after the initial tetrahedron
+  long long visibleFaces;    // Summed over the insertions
+  int maxVisibleFaces;
+  long long horizonEdges;    // Summed over the insertions
+  long long horizonHistogram[HULL_STATS_HORIZON_BUCKETS];
+  long long facesCreated;
+  long long facesDestroyed;
+  long long interiorPoints;  // Points found inside the hull and dropped
+  long long peakLiveFaces;
+} HullBuildStats;
+
+// Wall time of a build is split into these phases
+typedef enum HullPhase {
+  HULL_PHASE_PREFILTER = 0,   // HullBuildBegin: input copy, point filtering and setup
+  HULL_PHASE_INITIAL_SIMPLEX, // Finding the tetrahedron and assigning the outside points to it
+  HULL_PHASE_INSERTION,       // Every following step
+  HULL_PHASE_OUTPUT,          // HullBuildSnapshot
+  HULL_PHASE_COUNT
+} HullPhase;
+
+// Scalar a build decides its orientations on. Each has its own instantiation of both engines from
+// hull_build_template.h with its own plane filter and tie break, chosen once per step.
+typedef enum HullScalar {
+  HULL_SCALAR_FLOAT = 0,   // vertices, HullBuildBegin
+  HULL_SCALAR_DOUBLE,      // precise, HullBuildBeginDouble
+  HULL_SCALAR_GRID_NARROW, // grid within HULL_GRID_NARROW_MAX, 64 bit determinants
+  HULL_SCALAR_GRID,        // grid, HullGridDet determinants
+  HULL_SCALAR_COUNT
+} HullScalar;
+
+// Resumable hull construction.
+// One step is the same unit as in CreateConvexShape: step 1 forms the initial tetrahedron,
+// every following step processes the next input vertex, or the next in spatial order after HullBuildSpatialOrder. When every point lies in one plane the first step
+// finishes the build with the 2D hull instead, a double-sided polygon or for collinear points a segment.
+typedef struct HullBuild {
+  HullEngine engine;
+  int vertexCount;
+  HullVec3 *vertices;
+  int *order;        // Build index -> input index after HullBuildSpatialOrder, NULL in input order
+  float extent;      // Largest absolute coordinate, bounds the orientation filters
+  HullScalar scalar;
+  HullVec3i *grid;   // Quantised coordinates, NULL unless begun with HullBuildBeginQuantized
+  float gridStep;
+  HullVec3d *precise;   // Double coordinates, NULL unless begun with HullBuildBeginDouble
+  double preciseExtent; // Largest absolute double coordinate
+  int step;          // Steps done so far
+  int nextVertex;    // Next input vertex to insert
+  int simplex[4];    // Vertices of the initial tetrahedron, skipped by the insertions, -1 where none was found
+  bool finished;
+  bool degenerate;   // Fewer than two distinct points, there is no hull
+  int flatCount;     // Flat input: corners of its hull polygon, or the two ends of a collinear one. 0 otherwise
+  int *flatHull;
+  HullHistory *history; // Optional, receives every face created and destroyed
+  double phaseSeconds[HULL_PHASE_COUNT];
+  HullPerf *perf;       // Optional, not owned
+  HullPerfSample phaseCounters[HULL_PHASE_COUNT]; // Counter deltas per phase when perf is set
+  HullBuildStats stats; // Zero unless HULL_STATS_ENABLED
+
+  // HULL_ENGINE_INCREMENTAL
+  DoublyLinkedList *triangles;
+
+  // HULL_ENGINE_CONFLICT
+  int faceCount;
+  int faceCapacity;
+  HullBuildFace *faces;
+  int freeFace;       // Head of the free face slot list, chained through conflictHead
+  int liveFaceCount;
+  int *pointFace;     // Face the point is outside of, -1 once inserted or known to be inside
+  int *pointNext;     // Next point in the same conflict list
+  int *horizonStart;  // Vertex -> new face whose horizon edge starts there, -1 otherwise
+  int visibleCapacity;
+  int *visibleFaces;
+  int horizonCapacity;
+  int *horizonEdges;  // (a, b, face beyond the edge) per horizon edge
+  int newFaceCapacity;
+  int *newFaces;
+  int pendingCapacity;
+  int *pendingPoints; // Outside points of the destroyed faces
+} HullBuild;
+
+HullBuild *HullBuildBegin(HullVec3 v[], int n, HullEngine engine);
+// perf is passed here rather than set afterwards so the prefilter phase is counted too
+HullBuild *HullBuildBeginEx(HullVec3 v[], int n, HullEngine engine, HullPerf *perf);
+// Snaps the points to a grid of the given step and decides every orientation with exact integer arithmetic,
+// duplicates and coplanar points on the grid need no tolerance. The build's vertices and snapshots hold the
+// snapped points. Returns NULL when a coordinate is more than HULL_GRID_MAX steps away from the origin.
+HullBuild *HullBuildBeginQuantized(HullVec3 v[], int n, float gridStep, HullEngine engine, HullPerf *perf);
+// Decides every orientation on the double points, for input that float would round. The build's vertices and
+// snapshots hold the points rounded to float. Returns NULL unless every coordinate is zero or of a magnitude
+// within [2^-HULL_DOUBLE_MAX_EXPONENT, 2^HULL_DOUBLE_MAX_EXPONENT].
+HullBuild *HullBuildBeginDouble(HullVec3d v[], int n, HullEngine engine, HullPerf *perf);
+// Inserts the points in CreateHullSpatialOrder's order for fewer cache misses on large clouds, counted in the
+// prefilter phase. Snapshots and the history keep input indices, only ties between coplanar points may break
+// differently. Returns false once the build has taken a step.
+bool HullBuildSpatialOrder(HullBuild *build, int threadCount);
+int HullBuildStep(HullBuild *build, int steps);
+int HullBuildStepFor(HullBuild *build, double budgetMicros);
+ConvexShape *HullBuildSnapshot(HullBuild *build);
+void HullBuildEnd(HullBuild *build);
+const char *GetHullPhaseName(HullPhase phase);
+
+#endif
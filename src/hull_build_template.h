@@ -0,0 +1,240 @@
+// Both hull engines for one scalar, hull_build.c includes this once per HullScalar.
+// No include guard on purpose, every instantiation is generated at compile time from these parameters:
+//   HULL_B_FN(op)              name of the function op for this scalar
+//   HULL_B_V                   point type
+//   HULL_B_POINTS              member of HullBuild holding the points as HULL_B_V
+//   HULL_B_PLANE               member of the faces holding their plane
+//   HULL_B_PLANE_T             type of that member
+//   HULL_B_PLANE_INIT(plane, build, a, b, c)  plane through the points a, b and c
+//   HULL_B_DET_T               type of the determinant
+//   HULL_B_DECIDE(plane, p, det)  sets det, true when its sign is final
+//   HULL_B_SOS                 orientation of four indexed points with simulation of simplicity
+// The shared helpers come from hull_build.c. Every parameter is undefined again at the end.
+
+// p is the point's coordinates. Coplanar points are decided by the symbolic perturbation, no tolerance and no
+// dependence on the insertion order, so both engines build the same hull of the perturbed points.
+static inline bool HULL_B_FN(fSees)(const HullBuild *build, const HULL_B_PLANE_T *plane, const int indices[3], int point, HULL_B_V p)
+{
+  HULL_B_DET_T det;
+  if (HULL_B_DECIDE(plane, p, det))
+  {
+    return det > 0;
+  }
+  return HULL_B_SOS(build->HULL_B_POINTS, indices[0], indices[1], indices[2], point) > 0;
+}
+
+//----------------------------------------------------------------------------------
+// HULL_ENGINE_INCREMENTAL
+//----------------------------------------------------------------------------------
+
+static HullFace *HULL_B_FN(fNewHullFace)(HullBuild *build, int a, int b, int c)
+{
+  HullFace *face = fAllocHullFace(build, a, b, c);
+  HULL_B_PLANE_INIT(&face->HULL_B_PLANE, build, a, b, c);
+  return face;
+}
+
+static void HULL_B_FN(fIncrementalTetrahedron)(HullBuild *build, int tetrahedron[4][3])
+{
+  for (int i = 0; i < 4; i++)
+  {
+    DListPushBack(build->triangles, (void *)HULL_B_FN(fNewHullFace)(build, tetrahedron[i][0], tetrahedron[i][1], tetrahedron[i][2]));
+  }
+  HULL_STAT(build->stats.facesCreated += 4);
+}
+
+static void HULL_B_FN(fIncrementalInsert)(HullBuild *build, int newVertexIndex)
+{
+  DoublyLinkedList *triangles = build->triangles;
+  HullHistory *history = build->history;
+  HULL_B_V p = build->HULL_B_POINTS[newVertexIndex];
+  int visibleCount = 0;
+  // The horizon stores the edges surrounding the visible triangles
+  DoublyLinkedList *horizon = DListNew();
+  // Loop through all triangles and check if the new vertex can "see" them
+  // If it can, the triangle should be removed
+  DNode *current = triangles->head;
+  while (current != NULL)
+  {
+    HullFace *face = (HullFace *)current->data;
+    ConvexShapeTriangle *indexedTrig = &face->triangle;
+    HULL_STAT(build->stats.canSeeTests++);
+    if (HULL_B_FN(fSees)(build, &face->HULL_B_PLANE, indexedTrig->indices, newVertexIndex, p))
+    {
+      visibleCount++;
+      // If the edge is not share, it is part of the horizon
+      fTryAddHorizonEdgeIfUnique(horizon, fNewConvexShapeEdge(indexedTrig->indices[0], indexedTrig->indices[1]));
+      fTryAddHorizonEdgeIfUnique(horizon, fNewConvexShapeEdge(indexedTrig->indices[1], indexedTrig->indices[2]));
+      fTryAddHorizonEdgeIfUnique(horizon, fNewConvexShapeEdge(indexedTrig->indices[2], indexedTrig->indices[0]));
+
+      if (history)
+      {
+        HullHistoryRemoveFace(history, face->id);
+      }
+      DNode *temp = current;
+      current = current->next;
+      DListRemoveNode(triangles, temp);
+    }
+    else
+    {
+      current = current->next;
+    }
+  }
+
+  HULL_STAT(fRecordInsertion(&build->stats, visibleCount, horizon->size));
+  HULL_STAT(build->stats.facesDestroyed += visibleCount);
+  HULL_STAT(build->stats.facesCreated += horizon->size);
+  HULL_STAT(build->stats.interiorPoints += visibleCount == 0);
+
+  // Form new triangles with the horizon edges
+  // The correct order is guaranteed by adding the new vertex as the last vertex
+  current = horizon->head;
+  while (current)
+  {
+    ConvexShapeEdge *indexedEdge = (ConvexShapeEdge *)current->data;
+    HullFace *newFace = HULL_B_FN(fNewHullFace)(build, indexedEdge->indices[0], indexedEdge->indices[1], newVertexIndex);
+    DListPushBack(triangles, newFace);
+    current = current->next;
+  }
+
+  // Free the horizon
+  DListClear(horizon);
+  HullMemFree(horizon);
+}
+
+//----------------------------------------------------------------------------------
+// HULL_ENGINE_CONFLICT
+//----------------------------------------------------------------------------------
+
+static int HULL_B_FN(fNewBuildFace)(HullBuild *build, int a, int b, int c)
+{
+  int faceIndex = fAllocBuildFace(build, a, b, c);
+  HULL_B_PLANE_INIT(&build->faces[faceIndex].HULL_B_PLANE, build, a, b, c);
+  return faceIndex;
+}
+
+// Index of the first of the faces that sees the point, faceCount when none does. Points the filter cannot
+// decide are rare, they only go through the tie break when no face sees them outright.
+static int HULL_B_FN(fFirstSeeing)(HullBuild *build, const int faces[], int faceCount, int point)
+{
+  HULL_B_V p = build->HULL_B_POINTS[point];
+  int firstTie = -1;
+  for (int i = 0; i < faceCount; i++)
+  {
+    HULL_STAT(build->stats.canSeeTests++);
+    HULL_B_DET_T det;
+    if (!HULL_B_DECIDE(&build->faces[faces[i]].HULL_B_PLANE, p, det))
+    {
+      if (firstTie < 0) firstTie = i;
+    }
+    else if (det > 0)
+    {
+      return i;
+    }
+  }
+  for (int i = firstTie; firstTie >= 0 && i < faceCount; i++)
+  {
+    HullBuildFace *face = &build->faces[faces[i]];
+    if (HULL_B_FN(fSees)(build, &face->HULL_B_PLANE, face->indices, point, p))
+    {
+      return i;
+    }
+  }
+  return faceCount;
+}
+
+// Assigns every point to the first of the given faces it can see, or marks it as inside
+static void HULL_B_FN(fAssignConflicts)(HullBuild *build, const int faces[], int faceCount, const int points[], int pointCount)
+{
+  for (int k = 0; k < pointCount; k++)
+  {
+    int point = points[k];
+    int i = HULL_B_FN(fFirstSeeing)(build, faces, faceCount, point);
+    if (i < faceCount)
+    {
+      fAddConflict(build, faces[i], point);
+    }
+    else
+    {
+      build->pointFace[point] = -1;
+      HULL_STAT(build->stats.interiorPoints++);
+    }
+  }
+}
+
+static void HULL_B_FN(fConflictTetrahedron)(HullBuild *build, int tetrahedron[4][3])
+{
+  int faces[4];
+  for (int i = 0; i < 4; i++)
+  {
+    faces[i] = HULL_B_FN(fNewBuildFace)(build, tetrahedron[i][0], tetrahedron[i][1], tetrahedron[i][2]);
+  }
+  fLinkTetrahedron(build, faces);
+  int pendingCount = fPendingOutsideSimplex(build);
+  HULL_B_FN(fAssignConflicts)(build, faces, 4, build->pendingPoints, pendingCount);
+}
+
+static void HULL_B_FN(fConflictInsert)(HullBuild *build, int newVertexIndex)
+{
+  int startFace = build->pointFace[newVertexIndex];
+  if (startFace < 0)
+  {
+    // Inside the current hull, nothing changes. Counted as interior when it was dropped from its conflict list.
+    HULL_STAT(fRecordInsertion(&build->stats, 0, 0));
+    return;
+  }
+  HULL_B_V p = build->HULL_B_POINTS[newVertexIndex];
+  int mark = build->step;
+
+  // Flood the visible region starting from the conflict face
+  int visibleCount = 0;
+  build->faces[startFace].visitMark = mark;
+  build->faces[startFace].visible = true;
+  build->visibleFaces = DArrayReserve(build->visibleFaces, &build->visibleCapacity, 1, sizeof(int));
+  build->visibleFaces[visibleCount++] = startFace;
+  for (int v = 0; v < visibleCount; v++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int neighbor = build->faces[build->visibleFaces[v]].neighbors[k];
+      if (neighbor < 0 || build->faces[neighbor].visitMark == mark)
+      {
+        continue;
+      }
+      HullBuildFace *face = &build->faces[neighbor];
+      face->visitMark = mark;
+      HULL_STAT(build->stats.canSeeTests++);
+      face->visible = HULL_B_FN(fSees)(build, &face->HULL_B_PLANE, face->indices, newVertexIndex, p);
+      if (face->visible)
+      {
+        build->visibleFaces = DArrayReserve(build->visibleFaces, &build->visibleCapacity, visibleCount + 1, sizeof(int));
+        build->visibleFaces[visibleCount++] = neighbor;
+      }
+    }
+  }
+
+  int pendingCount = 0;
+  int horizonCount = fRemoveVisible(build, visibleCount, newVertexIndex, &pendingCount);
+
+  // Cone of new faces from the horizon to the new vertex
+  // The correct order is guaranteed by adding the new vertex as the last vertex
+  build->newFaces = DArrayReserve(build->newFaces, &build->newFaceCapacity, horizonCount, sizeof(int));
+  for (int e = 0; e < horizonCount; e++)
+  {
+    build->newFaces[e] = HULL_B_FN(fNewBuildFace)(build, build->horizonEdges[e * 3 + 0], build->horizonEdges[e * 3 + 1], newVertexIndex);
+  }
+  fLinkCone(build, horizonCount);
+
+  HULL_B_FN(fAssignConflicts)(build, build->newFaces, horizonCount, build->pendingPoints, pendingCount);
+  build->pointFace[newVertexIndex] = -1;
+}
+
+#undef HULL_B_FN
+#undef HULL_B_V
+#undef HULL_B_POINTS
+#undef HULL_B_PLANE
+#undef HULL_B_PLANE_T
+#undef HULL_B_PLANE_INIT
+#undef HULL_B_DET_T
+#undef HULL_B_DECIDE
+#undef HULL_B_SOS
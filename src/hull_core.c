@@ -0,0 +1,74 @@
+#include "hull_core.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HULL_LOG_MAX_LENGTH 256
+
+static void *fDefaultAlloc(size_t size, void *user)
+{
+  (void)user;
+  return malloc(size);
+}
+
+static void *fDefaultRealloc(void *ptr, size_t size, void *user)
+{
+  (void)user;
+  return realloc(ptr, size);
+}
+
+static void fDefaultFree(void *ptr, void *user)
+{
+  (void)user;
+  free(ptr);
+}
+
+static void fDefaultLog(HullLogLevel level, const char *message, void *user)
+{
+  (void)user;
+  static const char *prefixes[] = { "INFO", "WARNING", "ERROR" };
+  fprintf(stderr, "%s: %s\n", prefixes[level], message);
+}
+
+static HullAllocator allocator = { fDefaultAlloc, fDefaultRealloc, fDefaultFree, NULL };
+static HullLogCallback logCallback = fDefaultLog;
+static void *logUser = NULL;
+
+void HullSetAllocator(const HullAllocator *hooks)
+{
+  allocator = hooks != NULL ? *hooks : (HullAllocator){ fDefaultAlloc, fDefaultRealloc, fDefaultFree, NULL };
+}
+
+void HullSetLogCallback(HullLogCallback callback, void *user)
+{
+  logCallback = callback != NULL ? callback : fDefaultLog;
+  logUser = callback != NULL ? user : NULL;
+}
+
+void *HullMemAlloc(size_t size)
+{
+  void *ptr = allocator.alloc(size, allocator.user);
+  if (ptr != NULL) memset(ptr, 0, size);
+  return ptr;
+}
+
+void *HullMemRealloc(void *ptr, size_t size)
+{
+  return allocator.realloc(ptr, size, allocator.user);
+}
+
+void HullMemFree(void *ptr)
+{
+  if (ptr != NULL) allocator.free(ptr, allocator.user);
+}
+
+void HullLog(HullLogLevel level, const char *format, ...)
+{
+  char message[HULL_LOG_MAX_LENGTH];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+  logCallback(level, message, logUser);
+}
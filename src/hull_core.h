@@ -0,0 +1,82 @@
+#ifndef HULL_CORE_H_
+#define HULL_CORE_H_
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Base of the hull library: vector types, math, allocator and log hooks.
+// Nothing here depends on raylib, the viewer converts through convex_hull_draw.h.
+
+#define HULL_PI 3.14159265358979323846f
+#define HULL_EPSILON 0.000001f
+#define HULL_EPSILON_DOUBLE 1e-12
+
+// One vector type per scalar, generated from hull_scalar_template.h. Each has Add, Subtract, Scale,
+// DotProduct and Equals, the inexact ones CrossProduct and Normalize too. Orientation predicates tuned
+// per scalar are in hull_predicates.h.
+
+// HullVec3: float, input and output of the library. Same layout as raylib's Vector3
+#define HULL_T float
+#define HULL_T_WIDE float
+#define HULL_T_EXACT 0
+#define HULL_T_EPSILON HULL_EPSILON
+#define HULL_T_ABS fabsf
+#define HULL_T_MAX fmaxf
+#define HULL_T_SQRT sqrtf
+#define HULL_V HullVec3
+#define HULL_V_FN(op) HullVec3##op
+#include "hull_scalar_template.h"
+
+// HullVec3d: double, for checks and callers that need the precision
+#define HULL_T double
+#define HULL_T_WIDE double
+#define HULL_T_EXACT 0
+#define HULL_T_EPSILON HULL_EPSILON_DOUBLE
+#define HULL_T_ABS fabs
+#define HULL_T_MAX fmax
+#define HULL_T_SQRT sqrt
+#define HULL_V HullVec3d
+#define HULL_V_FN(op) HullVec3d##op
+#include "hull_scalar_template.h"
+
+// HullVec3i: int32 grid coordinates of quantised builds, dot products are exact within HULL_GRID_MAX
+#define HULL_T int32_t
+#define HULL_T_WIDE int64_t
+#define HULL_T_EXACT 1
+#define HULL_V HullVec3i
+#define HULL_V_FN(op) HullVec3i##op
+#include "hull_scalar_template.h"
+
+static inline HullVec3d HullVec3ToDouble(HullVec3 v)
+{
+  return (HullVec3d){ v.x, v.y, v.z };
+}
+
+typedef enum HullLogLevel {
+  HULL_LOG_INFO = 0,
+  HULL_LOG_WARNING,
+  HULL_LOG_ERROR
+} HullLogLevel;
+
+// Allocator hooks, every hull allocation goes through them.
+// alloc does not need to return zeroed memory, HullMemAlloc clears it. realloc is also called with a NULL ptr.
+typedef struct HullAllocator {
+  void *(*alloc)(size_t size, void *user);
+  void *(*realloc)(void *ptr, size_t size, void *user);
+  void (*free)(void *ptr, void *user);
+  void *user;
+} HullAllocator;
+
+typedef void (*HullLogCallback)(HullLogLevel level, const char *message, void *user);
+
+// NULL hooks restore the C library defaults. Set them before any hull object is created.
+void HullSetAllocator(const HullAllocator *hooks);
+void HullSetLogCallback(HullLogCallback callback, void *user);
+
+void *HullMemAlloc(size_t size); // Zero initialized
+void *HullMemRealloc(void *ptr, size_t size);
+void HullMemFree(void *ptr);
+void HullLog(HullLogLevel level, const char *format, ...);
+
+#endif
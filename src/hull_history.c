@@ -0,0 +1,273 @@
+#include "hull_history.h"
+#include "dynamic_array.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void fLiveAdd(HullHistory *history, int faceId)
+{
+  history->livePosition[faceId] = history->liveCount;
+  history->liveFaces[history->liveCount++] = faceId;
+}
+
+static void fLiveRemove(HullHistory *history, int faceId)
+{
+  // Swap with the last live face to keep the list dense
+  int position = history->livePosition[faceId];
+  int lastFaceId = history->liveFaces[--history->liveCount];
+  history->liveFaces[position] = lastFaceId;
+  history->livePosition[lastFaceId] = position;
+  history->livePosition[faceId] = -1;
+}
+
+static void fLiveReset(HullHistory *history)
+{
+  for (int i = 0; i < history->liveCount; i++)
+  {
+    history->livePosition[history->liveFaces[i]] = -1;
+  }
+  history->liveCount = 0;
+}
+
+// Number of journal entries (created + destroyed faces) applied to reach the state after `step` steps
+static int fJournalPosition(HullHistory *history, int step)
+{
+  if (step >= history->stepCount)
+  {
+    return history->faceCount + history->destroyedCount;
+  }
+  return history->steps[step].createdBegin + history->steps[step].destroyedBegin;
+}
+
+static void fApplyStepForward(HullHistory *history, int step)
+{
+  HullHistoryStep *s = &history->steps[step];
+  for (int i = s->destroyedBegin; i < s->destroyedEnd; i++)
+  {
+    fLiveRemove(history, history->destroyedFaces[i]);
+  }
+  for (int id = s->createdBegin; id < s->createdEnd; id++)
+  {
+    fLiveAdd(history, id);
+  }
+}
+
+static void fApplyStepBackward(HullHistory *history, int step)
+{
+  HullHistoryStep *s = &history->steps[step];
+  for (int id = s->createdBegin; id < s->createdEnd; id++)
+  {
+    fLiveRemove(history, id);
+  }
+  for (int i = s->destroyedBegin; i < s->destroyedEnd; i++)
+  {
+    fLiveAdd(history, history->destroyedFaces[i]);
+  }
+}
+
+static void fRestoreCheckpoint(HullHistory *history, HullHistoryCheckpoint *checkpoint)
+{
+  fLiveReset(history);
+  for (int i = 0; i < checkpoint->liveCount; i++)
+  {
+    fLiveAdd(history, checkpoint->liveFaces[i]);
+  }
+  history->currentStep = checkpoint->step;
+}
+
+// Moves the cursor to `step` starting from whichever is closest in journal entries:
+// the cursor itself, the nearest checkpoint before or after `step`, or the empty state
+static void fMoveCursor(HullHistory *history, int step)
+{
+  int target = fJournalPosition(history, step);
+  int bestCost = abs(fJournalPosition(history, history->currentStep) - target);
+  HullHistoryCheckpoint *best = NULL;
+  int restartFromEmpty = 0;
+
+  if (history->liveCount + target < bestCost)
+  {
+    bestCost = history->liveCount + target;
+    restartFromEmpty = 1;
+  }
+
+  // Last checkpoint with checkpoint.step <= step
+  int low = 0;
+  int high = history->checkpointCount - 1;
+  int before = -1;
+  while (low <= high)
+  {
+    int mid = (low + high) / 2;
+    if (history->checkpoints[mid].step <= step)
+    {
+      before = mid;
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid - 1;
+    }
+  }
+  for (int i = before; i <= before + 1; i++)
+  {
+    if (i < 0 || i >= history->checkpointCount)
+    {
+      continue;
+    }
+    HullHistoryCheckpoint *checkpoint = &history->checkpoints[i];
+    int cost = history->liveCount + checkpoint->liveCount + abs(fJournalPosition(history, checkpoint->step) - target);
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      best = checkpoint;
+      restartFromEmpty = 0;
+    }
+  }
+
+  if (best)
+  {
+    fRestoreCheckpoint(history, best);
+  }
+  else if (restartFromEmpty)
+  {
+    fLiveReset(history);
+    history->currentStep = 0;
+  }
+
+  while (history->currentStep < step)
+  {
+    fApplyStepForward(history, history->currentStep);
+    history->currentStep++;
+  }
+  while (history->currentStep > step)
+  {
+    history->currentStep--;
+    fApplyStepBackward(history, history->currentStep);
+  }
+}
+
+static void fMaybeCheckpoint(HullHistory *history)
+{
+  int lastStep = history->checkpointCount > 0 ? history->checkpoints[history->checkpointCount - 1].step : 0;
+  int distance = fJournalPosition(history, history->stepCount) - fJournalPosition(history, lastStep);
+  if (distance < HULL_HISTORY_MIN_CHECKPOINT_DISTANCE || distance < history->liveCount)
+  {
+    return;
+  }
+
+  history->checkpoints = DArrayReserve(history->checkpoints, &history->checkpointCapacity, history->checkpointCount + 1, sizeof(HullHistoryCheckpoint));
+  HullHistoryCheckpoint *checkpoint = &history->checkpoints[history->checkpointCount++];
+  checkpoint->step = history->stepCount;
+  checkpoint->liveCount = history->liveCount;
+  checkpoint->liveFaces = HullMemAlloc(sizeof(int) * (history->liveCount > 0 ? history->liveCount : 1));
+  memcpy(checkpoint->liveFaces, history->liveFaces, sizeof(int) * history->liveCount);
+}
+
+HullHistory *CreateHullHistory(HullVec3 v[], int n)
+{
+  HullHistory *history = HullMemAlloc(sizeof(HullHistory));
+  *history = (HullHistory){0};
+  history->vertexCount = n;
+  history->vertices = HullMemAlloc(sizeof(HullVec3) * (n > 0 ? n : 1));
+  memcpy(history->vertices, v, sizeof(HullVec3) * n);
+  return history;
+}
+
+ConvexShape *HullHistorySeek(HullHistory *history, int step)
+{
+  if (history == NULL || history->stepCount == 0 || step == 0)
+  {
+    return NULL;
+  }
+  // Negative step means the final result, just like CreateConvexShape
+  if (step < 0 || step > history->stepCount)
+  {
+    step = history->stepCount;
+  }
+  fMoveCursor(history, step);
+
+  history->shape.triangles = DArrayReserve(history->shape.triangles, &history->shapeTriangleCapacity, history->liveCount, sizeof(ConvexShapeTriangle));
+  for (int i = 0; i < history->liveCount; i++)
+  {
+    history->shape.triangles[i] = history->faces[history->liveFaces[i]];
+  }
+  history->shape.triangleCount = history->liveCount;
+  bool segment = history->segmentStep > 0 && step >= history->segmentStep;
+  history->shape.edgeCount = segment ? 1 : 0;
+  history->shape.edges = segment ? &history->segment : NULL;
+  history->shape.vertexCount = history->vertexCount;
+  history->shape.vertices = history->vertices;
+  return &history->shape;
+}
+
+void ClearHullHistory(HullHistory *history)
+{
+  if (history == NULL)
+  {
+    return;
+  }
+  for (int i = 0; i < history->checkpointCount; i++)
+  {
+    HullMemFree(history->checkpoints[i].liveFaces);
+  }
+  HullMemFree(history->checkpoints);
+  HullMemFree(history->steps);
+  HullMemFree(history->faces);
+  HullMemFree(history->destroyedFaces);
+  HullMemFree(history->liveFaces);
+  HullMemFree(history->livePosition);
+  HullMemFree(history->shape.triangles);
+  HullMemFree(history->vertices);
+  *history = (HullHistory){0};
+}
+
+void HullHistoryBeginStep(HullHistory *history)
+{
+  // The history may have been seeked while recording, faces are always recorded against the latest state
+  if (history->currentStep != history->stepCount)
+  {
+    fMoveCursor(history, history->stepCount);
+  }
+  fMaybeCheckpoint(history);
+
+  history->steps = DArrayReserve(history->steps, &history->stepCapacity, history->stepCount + 1, sizeof(HullHistoryStep));
+  history->steps[history->stepCount++] = (HullHistoryStep){
+    history->faceCount,
+    history->faceCount,
+    history->destroyedCount,
+    history->destroyedCount
+  };
+  history->currentStep = history->stepCount;
+}
+
+int HullHistoryAddFace(HullHistory *history, ConvexShapeTriangle triangle)
+{
+  int faceId = history->faceCount;
+  int capacity = history->faceCapacity;
+  history->faces = DArrayReserve(history->faces, &history->faceCapacity, faceId + 1, sizeof(ConvexShapeTriangle));
+  if (capacity != history->faceCapacity)
+  {
+    // The live set is indexed by face id, keep it as large as the face array
+    history->liveFaces = HullMemRealloc(history->liveFaces, sizeof(int) * history->faceCapacity);
+    history->livePosition = HullMemRealloc(history->livePosition, sizeof(int) * history->faceCapacity);
+  }
+
+  history->faces[faceId] = triangle;
+  history->faceCount++;
+  history->livePosition[faceId] = -1;
+  fLiveAdd(history, faceId);
+  history->steps[history->stepCount - 1].createdEnd = history->faceCount;
+  return faceId;
+}
+
+void HullHistoryRemoveFace(HullHistory *history, int faceId)
+{
+  history->destroyedFaces = DArrayReserve(history->destroyedFaces, &history->destroyedCapacity, history->destroyedCount + 1, sizeof(int));
+  history->destroyedFaces[history->destroyedCount++] = faceId;
+  history->steps[history->stepCount - 1].destroyedEnd = history->destroyedCount;
+  fLiveRemove(history, faceId);
+}
+
+void HullHistorySetSegment(HullHistory *history, ConvexShapeEdge segment)
+{
+  history->segmentStep = history->stepCount;
+  history->segment = segment;
+}
@@ -0,0 +1,77 @@
+#ifndef HULL_HISTORY_H_
+#define HULL_HISTORY_H_
+#include "hull_core.h"
+#include "convex_hull.h"
+
+// A checkpoint is taken once the journal has grown by at least this many
+// entries AND by at least the size of the live face set since the last one,
+// so checkpoints never cost more memory than the journal itself.
+#define HULL_HISTORY_MIN_CHECKPOINT_DISTANCE 64
+
+// Faces created and destroyed by one build step.
+// Face ids are handed out sequentially, so the created faces of a step are a contiguous id range.
+typedef struct HullHistoryStep {
+  int createdBegin;
+  int createdEnd;
+  int destroyedBegin; // Range into HullHistory.destroyedFaces
+  int destroyedEnd;
+} HullHistoryStep;
+
+// Full copy of the live face set after `step` steps have been applied
+typedef struct HullHistoryCheckpoint {
+  int step;
+  int liveCount;
+  int *liveFaces;
+} HullHistoryCheckpoint;
+
+// Construction journal of a hull build.
+// steps[0] creates the initial tetrahedron, every following step is one vertex insertion,
+// which matches the meaning of `step` in CreateConvexShape.
+// The history is filled by a HullBuild whose `history` points to it, and can be seeked while it is still recording.
+typedef struct HullHistory {
+  int vertexCount;
+  HullVec3 *vertices;
+
+  int faceCount;
+  int faceCapacity;
+  ConvexShapeTriangle *faces; // Every face ever created, indexed by face id
+
+  int destroyedCount;
+  int destroyedCapacity;
+  int *destroyedFaces;
+
+  int stepCount;
+  int stepCapacity;
+  HullHistoryStep *steps;
+
+  int checkpointCount;
+  int checkpointCapacity;
+  HullHistoryCheckpoint *checkpoints;
+
+  // Cursor: the live face set after `currentStep` steps
+  int currentStep;
+  int liveCount;
+  int *liveFaces;    // Dense list of live face ids
+  int *livePosition; // Face id -> index into liveFaces, -1 when the face is not live
+
+  // Collinear input: the segment, part of every seek to segmentStep or later. 0 when there is none
+  int segmentStep;
+  ConvexShapeEdge segment;
+
+  // View handed out by HullHistorySeek, vertices are shared with the history
+  ConvexShape shape;
+  int shapeTriangleCapacity;
+} HullHistory;
+
+HullHistory *CreateHullHistory(HullVec3 v[], int n);
+ConvexShape *HullHistorySeek(HullHistory *history, int step);
+void ClearHullHistory(HullHistory *history);
+
+// Recording, used by HullBuild
+void HullHistoryBeginStep(HullHistory *history);
+int HullHistoryAddFace(HullHistory *history, ConvexShapeTriangle triangle);
+void HullHistoryRemoveFace(HullHistory *history, int faceId);
+// The current step's result is a segment, seeks from this step on return it in edges
+void HullHistorySetSegment(HullHistory *history, ConvexShapeEdge segment);
+
+#endif
@@ -0,0 +1,295 @@
+#include "hull_io.h"
+#include "hull_parallel.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// A line belongs to the block its first character is in
+#define HULL_IO_BLOCK_SIZE 1024
+#define HULL_IO_READ_CHUNK (16 * 1024 * 1024)
+
+typedef struct PointFileContext {
+  const char *text;
+  size_t size;
+  int *blockCounts; // Points per block, turned into offsets between the two passes
+  HullVec3 *points;
+  atomic_int malformedBlock; // Any block with a bad point line, -1 when there is none
+} PointFileContext;
+
+static bool fIsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Points at the first number of a point line, NULL when the line is not a point
+static const char *fPointLineStart(const char *line, const char *lineEnd)
+{
+  while (line < lineEnd && fIsSpace(*line)) line++;
+  if (line == lineEnd) return NULL;
+
+  char c = *line;
+  if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.')
+  {
+    return line;
+  }
+  if (c == 'v' && line + 1 < lineEnd && fIsSpace(line[1]))
+  {
+    return line + 1;
+  }
+  return NULL;
+}
+
+static bool fParsePoint(const char *start, const char *lineEnd, HullVec3 *point)
+{
+  float xyz[3];
+  const char *cursor = start;
+  for (int i = 0; i < 3; i++)
+  {
+    char *numberEnd;
+    xyz[i] = strtof(cursor, &numberEnd);
+    // strtof skips newlines as whitespace, a short line must not borrow from the next one
+    if (numberEnd == cursor || numberEnd > lineEnd) return false;
+    cursor = numberEnd;
+  }
+  *point = (HullVec3){ xyz[0], xyz[1], xyz[2] };
+  return true;
+}
+
+// Counts the point lines starting in the block, parses them into out unless it is NULL
+static int fScanBlock(PointFileContext *ctx, int block, HullVec3 *out)
+{
+  const char *text = ctx->text;
+  size_t begin = (size_t)block * HULL_IO_BLOCK_SIZE;
+  size_t end = begin + HULL_IO_BLOCK_SIZE < ctx->size ? begin + HULL_IO_BLOCK_SIZE : ctx->size;
+
+  size_t line = begin;
+  if (line > 0 && text[line - 1] != '\n')
+  {
+    const char *next = memchr(text + line, '\n', end - line);
+    if (next == NULL) return 0;
+    line = next - text + 1;
+  }
+
+  int count = 0;
+  while (line < end)
+  {
+    const char *lineEnd = memchr(text + line, '\n', ctx->size - line);
+    if (lineEnd == NULL) lineEnd = text + ctx->size;
+
+    const char *start = fPointLineStart(text + line, lineEnd);
+    if (start != NULL)
+    {
+      if (out != NULL && !fParsePoint(start, lineEnd, &out[count]))
+      {
+        out[count] = (HullVec3){0};
+        atomic_store(&ctx->malformedBlock, block); // Which failing block gets reported does not matter
+      }
+      count++;
+    }
+    line = lineEnd - text + 1;
+  }
+  return count;
+}
+
+static void fCountRange(void *context, int begin, int end)
+{
+  PointFileContext *ctx = (PointFileContext *)context;
+  for (int block = begin; block < end; block++)
+  {
+    ctx->blockCounts[block] = fScanBlock(ctx, block, NULL);
+  }
+}
+
+static void fParseRange(void *context, int begin, int end)
+{
+  PointFileContext *ctx = (PointFileContext *)context;
+  for (int block = begin; block < end; block++)
+  {
+    fScanBlock(ctx, block, ctx->points + ctx->blockCounts[block]);
+  }
+}
+
+// Whole file plus a terminating zero, so strtof never runs off the end
+static char *fReadText(const char *fileName, size_t *size)
+{
+  FILE *file = fopen(fileName, "rb");
+  if (file == NULL) return NULL;
+
+  size_t capacity = HULL_IO_READ_CHUNK;
+  size_t length = 0;
+  char *text = HullMemRealloc(NULL, capacity + 1);
+  while (text != NULL)
+  {
+    if (length == capacity)
+    {
+      capacity *= 2;
+      char *grown = HullMemRealloc(text, capacity + 1);
+      if (grown == NULL)
+      {
+        HullMemFree(text);
+        text = NULL;
+        break;
+      }
+      text = grown;
+    }
+    size_t read = fread(text + length, 1, capacity - length, file);
+    length += read;
+    if (read == 0) break;
+  }
+  bool failed = ferror(file);
+  fclose(file);
+  if (text == NULL || failed)
+  {
+    HullMemFree(text);
+    return NULL;
+  }
+  text[length] = '\0';
+  *size = length;
+  return text;
+}
+
+bool LoadPointFile(const char *fileName, PointCloud *cloud, bool hugePages, int threadCount)
+{
+  size_t size = 0;
+  char *text = fReadText(fileName, &size);
+  if (text == NULL)
+  {
+    HullLog(HULL_LOG_WARNING, "POINTS: [%s] Failed to read file", fileName);
+    return false;
+  }
+
+  // NOTE: One count per block, keeps the block index in an int up to 2 TB of text
+  int blockCount = (int)((size + HULL_IO_BLOCK_SIZE - 1) / HULL_IO_BLOCK_SIZE);
+  PointFileContext ctx = {
+    .text = text,
+    .size = size,
+    .blockCounts = HullMemRealloc(NULL, sizeof(int) * (size_t)(blockCount > 0 ? blockCount : 1))
+  };
+  atomic_init(&ctx.malformedBlock, -1);
+
+  HullParallelFor(blockCount, threadCount, fCountRange, &ctx);
+  long long total = 0;
+  for (int block = 0; block < blockCount; block++)
+  {
+    int count = ctx.blockCounts[block];
+    ctx.blockCounts[block] = (int)total;
+    total += count;
+  }
+
+  bool loaded = total <= MAX_POINT_CLOUD_COUNT;
+  if (loaded)
+  {
+    *cloud = CreatePointCloud((int)total, hugePages);
+    ctx.points = cloud->points;
+    loaded = cloud->points != NULL;
+  }
+  if (loaded)
+  {
+    HullParallelFor(blockCount, threadCount, fParseRange, &ctx);
+    int malformedBlock = atomic_load(&ctx.malformedBlock);
+    if (malformedBlock >= 0)
+    {
+      HullLog(HULL_LOG_WARNING, "POINTS: [%s] Malformed point line near byte %lld", fileName, (long long)malformedBlock * HULL_IO_BLOCK_SIZE);
+      ClearPointCloud(cloud);
+      loaded = false;
+    }
+  }
+  else if (total > MAX_POINT_CLOUD_COUNT)
+  {
+    HullLog(HULL_LOG_WARNING, "POINTS: [%s] More than %d points", fileName, MAX_POINT_CLOUD_COUNT);
+  }
+
+  HullMemFree(ctx.blockCounts);
+  HullMemFree(text);
+  return loaded;
+}
+
+bool SavePointFile(const char *fileName, HullVec3 v[], int n)
+{
+  FILE *file = fopen(fileName, "w");
+  if (file == NULL) return false;
+
+  for (int i = 0; i < n; i++)
+  {
+    fprintf(file, "%.9g %.9g %.9g\n", v[i].x, v[i].y, v[i].z);
+  }
+  return fclose(file) == 0;
+}
+
+bool SaveConvexShapeObj(const char *fileName, ConvexShape *convexShape)
+{
+  FILE *file = fopen(fileName, "w");
+  if (file == NULL) return false;
+
+  int triangleCount = convexShape != NULL ? convexShape->triangleCount : 0;
+  int edgeCount = convexShape != NULL ? convexShape->edgeCount : 0;
+  int vertexCount = convexShape != NULL ? convexShape->vertexCount : 0;
+  // Input index -> 1-based OBJ index, 0 while the vertex is unused
+  int *objIndex = HullMemAlloc(sizeof(int) * (size_t)(vertexCount > 0 ? vertexCount : 1));
+  int objVertexCount = 0;
+
+  for (int i = 0; i < triangleCount; i++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int index = convexShape->triangles[i].indices[k];
+      if (objIndex[index] == 0)
+      {
+        HullVec3 p = convexShape->vertices[index];
+        objIndex[index] = ++objVertexCount;
+        fprintf(file, "v %.9g %.9g %.9g\n", p.x, p.y, p.z);
+      }
+    }
+  }
+  for (int i = 0; i < edgeCount; i++)
+  {
+    for (int k = 0; k < 2; k++)
+    {
+      int index = convexShape->edges[i].indices[k];
+      if (objIndex[index] == 0)
+      {
+        HullVec3 p = convexShape->vertices[index];
+        objIndex[index] = ++objVertexCount;
+        fprintf(file, "v %.9g %.9g %.9g\n", p.x, p.y, p.z);
+      }
+    }
+  }
+  for (int i = 0; i < triangleCount; i++)
+  {
+    int *indices = convexShape->triangles[i].indices;
+    fprintf(file, "f %d %d %d\n", objIndex[indices[0]], objIndex[indices[1]], objIndex[indices[2]]);
+  }
+  // The segment of a collinear input as an OBJ line element
+  for (int i = 0; i < edgeCount; i++)
+  {
+    fprintf(file, "l %d %d\n", objIndex[convexShape->edges[i].indices[0]], objIndex[convexShape->edges[i].indices[1]]);
+  }
+
+  HullMemFree(objIndex);
+  return fclose(file) == 0;
+}
+
+bool SaveHullPolyhedronObj(const char *fileName, const HullPolyhedron *polyhedron)
+{
+  FILE *file = fopen(fileName, "w");
+  if (file == NULL) return false;
+
+  int vertexCount = polyhedron != NULL ? polyhedron->vertexCount : 0;
+  int faceCount = polyhedron != NULL ? polyhedron->faceCount : 0;
+  for (int i = 0; i < vertexCount; i++)
+  {
+    HullVec3 p = polyhedron->vertices[i];
+    fprintf(file, "v %.9g %.9g %.9g\n", p.x, p.y, p.z);
+  }
+  for (int f = 0; f < faceCount; f++)
+  {
+    fputc('f', file);
+    for (int i = polyhedron->faceStart[f]; i < polyhedron->faceStart[f + 1]; i++)
+    {
+      fprintf(file, " %d", polyhedron->indices[i] + 1);
+    }
+    fputc('\n', file);
+  }
+  return fclose(file) == 0;
+}
@@ -0,0 +1,18 @@
+#ifndef HULL_IO_H_
+#define HULL_IO_H_
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_polyhedron.h"
+#include "point_cloud.h"
+
+// Text point files: one "x y z" triple per line, or the "v x y z" lines of a Wavefront OBJ.
+// Blank lines, comments and other OBJ records are skipped.
+// Parsing is split across threadCount threads (<= 0 uses every core), the result does not depend on it.
+bool LoadPointFile(const char *fileName, PointCloud *cloud, bool hugePages, int threadCount);
+bool SavePointFile(const char *fileName, HullVec3 v[], int n);
+// Writes only the vertices the hull uses, faces keep their winding
+bool SaveConvexShapeObj(const char *fileName, ConvexShape *convexShape);
+// One polygon record per face
+bool SaveHullPolyhedronObj(const char *fileName, const HullPolyhedron *polyhedron);
+
+#endif
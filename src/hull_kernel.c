@@ -0,0 +1,323 @@
+#include "hull_kernel.h"
+#include "convex_hull.h"
+#include "hull_order.h"
+#include "hull_parallel.h"
+#include "hull_trace.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <string.h>
+
+// Points per block of the bounding box pass, every block keeps its own bounds
+#define HULL_KERNEL_BLOCK (1 << 16)
+#define HULL_KERNEL_EMPTY UINT64_MAX
+
+typedef struct HullKernelContext {
+  const HullVec3 *v;
+  int n;
+  float *bounds;       // Per block: low x, y, z then high x, y, z
+  int *finiteCounts;   // Per block
+  int axis;            // Columns run along the longest axis
+  double low[3];
+  double cellSize;
+  int cells[3];
+  atomic_ullong *first; // Column -> smallest key of its points, HULL_KERNEL_EMPTY when empty
+  atomic_ullong *last;  // Column -> largest key
+} HullKernelContext;
+
+static bool fIsFinite(HullVec3 p)
+{
+  return isfinite(p.x) && isfinite(p.y) && isfinite(p.z);
+}
+
+// Coordinate along the axis in the high half, so keys order like coordinates, then by input index
+static uint64_t fKey(float coordinate, int index)
+{
+  uint32_t bits;
+  memcpy(&bits, &coordinate, sizeof(bits));
+  bits = bits & 0x80000000U ? ~bits : bits | 0x80000000U;
+  return (uint64_t)bits << 32 | (uint32_t)index;
+}
+
+static void fBoundBlocks(void *context, int begin, int end)
+{
+  HullKernelContext *ctx = (HullKernelContext *)context;
+  for (int block = begin; block < end; block++)
+  {
+    float *bounds = ctx->bounds + (size_t)block * 6;
+    for (int k = 0; k < 3; k++)
+    {
+      bounds[k] = INFINITY;
+      bounds[3 + k] = -INFINITY;
+    }
+    int count = 0;
+    int last = ctx->n - block * HULL_KERNEL_BLOCK > HULL_KERNEL_BLOCK ? (block + 1) * HULL_KERNEL_BLOCK : ctx->n;
+    for (int i = block * HULL_KERNEL_BLOCK; i < last; i++)
+    {
+      if (!fIsFinite(ctx->v[i])) continue;
+      float coordinates[3] = { ctx->v[i].x, ctx->v[i].y, ctx->v[i].z };
+      for (int k = 0; k < 3; k++)
+      {
+        bounds[k] = fminf(bounds[k], coordinates[k]);
+        bounds[3 + k] = fmaxf(bounds[3 + k], coordinates[k]);
+      }
+      count++;
+    }
+    ctx->finiteCounts[block] = count;
+  }
+}
+
+static void fColumnRange(void *context, int begin, int end)
+{
+  HullKernelContext *ctx = (HullKernelContext *)context;
+  int u = (ctx->axis + 1) % 3, w = (ctx->axis + 2) % 3;
+  for (int i = begin; i < end; i++)
+  {
+    if (!fIsFinite(ctx->v[i])) continue;
+    float coordinates[3] = { ctx->v[i].x, ctx->v[i].y, ctx->v[i].z };
+    int cu = (int)(((double)coordinates[u] - ctx->low[u]) / ctx->cellSize);
+    int cw = (int)(((double)coordinates[w] - ctx->low[w]) / ctx->cellSize);
+    cu = cu < ctx->cells[u] ? cu : ctx->cells[u] - 1;
+    cw = cw < ctx->cells[w] ? cw : ctx->cells[w] - 1;
+    int column = cu * ctx->cells[w] + cw;
+    uint64_t key = fKey(coordinates[ctx->axis], i);
+    uint64_t current = atomic_load_explicit(&ctx->first[column], memory_order_relaxed);
+    while (key < current && !atomic_compare_exchange_weak_explicit(&ctx->first[column], &current, key, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+    current = atomic_load_explicit(&ctx->last[column], memory_order_relaxed);
+    while (key > current && !atomic_compare_exchange_weak_explicit(&ctx->last[column], &current, key, memory_order_relaxed, memory_order_relaxed))
+    {
+    }
+  }
+}
+
+static double fDot(HullVec3 p, const double direction[3])
+{
+  return p.x * direction[0] + p.y * direction[1] + p.z * direction[2];
+}
+
+// Hill climbing over the edges of the hull, a vertex with no better neighbour is extreme on a convex polytope
+static int fExtremeVertex(const ConvexShape *shape, const int *adjacencyStart, const int *adjacency, int start, const double direction[3])
+{
+  int vertex = start;
+  double best = fDot(shape->vertices[vertex], direction);
+  for (int current = -1; current != vertex;)
+  {
+    current = vertex;
+    for (int a = adjacencyStart[current]; a < adjacencyStart[current + 1]; a++)
+    {
+      double value = fDot(shape->vertices[adjacency[a]], direction);
+      if (value > best)
+      {
+        best = value;
+        vertex = adjacency[a];
+      }
+    }
+  }
+  return vertex;
+}
+
+// Marks the extreme vertex of shape in every direction of a g x g grid on each face of a cube
+static void fSampleDirections(const ConvexShape *shape, int g, bool *used)
+{
+  int vertexCount = shape->vertexCount;
+  int *adjacencyStart = HullMemAlloc(sizeof(int) * (size_t)(vertexCount + 1));
+  int *adjacency = HullMemAlloc(sizeof(int) * 6 * (size_t)(shape->triangleCount > 0 ? shape->triangleCount : 1));
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      adjacencyStart[shape->triangles[t].indices[k] + 1] += 2;
+    }
+  }
+  for (int i = 0; i < vertexCount; i++)
+  {
+    adjacencyStart[i + 1] += adjacencyStart[i];
+  }
+  int *next = HullMemAlloc(sizeof(int) * (size_t)(vertexCount > 0 ? vertexCount : 1));
+  memcpy(next, adjacencyStart, sizeof(int) * (size_t)vertexCount);
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    const int *indices = shape->triangles[t].indices;
+    for (int k = 0; k < 3; k++)
+    {
+      adjacency[next[indices[k]]++] = indices[(k + 1) % 3];
+      adjacency[next[indices[k]]++] = indices[(k + 2) % 3];
+    }
+  }
+
+  int vertex = shape->triangles[0].indices[0];
+  for (int face = 0; face < 6; face++)
+  {
+    int a = face >> 1, b = (a + 1) % 3, c = (a + 2) % 3;
+    for (int i = 0; i < g; i++)
+    {
+      // Rows alternate direction so consecutive directions stay neighbours and the walks stay short
+      for (int s = 0; s < g; s++)
+      {
+        int j = i & 1 ? g - 1 - s : s;
+        double direction[3];
+        direction[a] = face & 1 ? -1.0 : 1.0;
+        direction[b] = -1.0 + (2.0 * i + 1.0) / g;
+        direction[c] = -1.0 + (2.0 * j + 1.0) / g;
+        vertex = fExtremeVertex(shape, adjacencyStart, adjacency, vertex, direction);
+        used[vertex] = true;
+      }
+    }
+  }
+
+  HullMemFree(next);
+  HullMemFree(adjacency);
+  HullMemFree(adjacencyStart);
+}
+
+HullKernel *CreateHullKernel(const HullVec3 v[], int n, float epsilon, int threadCount)
+{
+  if (!(epsilon >= HULL_KERNEL_MIN_EPSILON && epsilon <= 1.0f))
+  {
+    return NULL;
+  }
+
+  HullTraceBegin("CreateHullKernel");
+  HullKernel *kernel = HullMemAlloc(sizeof(HullKernel));
+  kernel->epsilon = epsilon;
+  HullKernelContext ctx = { .v = v, .n = n };
+  int blockCount = (n + HULL_KERNEL_BLOCK - 1) / HULL_KERNEL_BLOCK;
+  ctx.bounds = HullMemAlloc(sizeof(float) * 6 * (size_t)(blockCount > 0 ? blockCount : 1));
+  ctx.finiteCounts = HullMemAlloc(sizeof(int) * (size_t)(blockCount > 0 ? blockCount : 1));
+  HullParallelForEx(blockCount, 1, threadCount, fBoundBlocks, &ctx);
+  double high[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for (int k = 0; k < 3; k++) ctx.low[k] = INFINITY;
+  for (int block = 0; block < blockCount; block++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      ctx.low[k] = fmin(ctx.low[k], ctx.bounds[block * 6 + k]);
+      high[k] = fmax(high[k], ctx.bounds[block * 6 + 3 + k]);
+    }
+    kernel->inputCount += ctx.finiteCounts[block];
+  }
+  HullMemFree(ctx.finiteCounts);
+  HullMemFree(ctx.bounds);
+
+  // Half of the error goes to the columns: every point is within a column diagonal of the segment between
+  // the two ends of its column
+  double diagonal = 0.0, span = 0.0;
+  for (int k = 0; k < 3 && kernel->inputCount > 0; k++)
+  {
+    diagonal += (high[k] - ctx.low[k]) * (high[k] - ctx.low[k]);
+    if (high[k] - ctx.low[k] > span)
+    {
+      span = high[k] - ctx.low[k];
+      ctx.axis = k;
+    }
+  }
+  diagonal = sqrt(diagonal);
+  kernel->errorBound = nextafterf((float)(epsilon * diagonal), INFINITY);
+  ctx.cellSize = epsilon * diagonal / (2.0 * sqrt(2.0));
+  int u = (ctx.axis + 1) % 3, w = (ctx.axis + 2) % 3;
+  for (int k = 0; k < 3; k++)
+  {
+    ctx.cells[k] = span > 0.0 ? (int)((high[k] - ctx.low[k]) / ctx.cellSize) + 1 : 1;
+  }
+  int columnCount = kernel->inputCount > 0 ? ctx.cells[u] * ctx.cells[w] : 0;
+  ctx.first = HullMemAlloc(sizeof(atomic_ullong) * (size_t)(columnCount > 0 ? columnCount : 1));
+  ctx.last = HullMemAlloc(sizeof(atomic_ullong) * (size_t)(columnCount > 0 ? columnCount : 1));
+  for (int c = 0; c < columnCount; c++)
+  {
+    atomic_init(&ctx.first[c], HULL_KERNEL_EMPTY);
+    atomic_init(&ctx.last[c], 0);
+  }
+  if (span > 0.0)
+  {
+    HullParallelFor(n, threadCount, fColumnRange, &ctx);
+  }
+
+  // Ends of every column, in column order so the result does not depend on the thread count
+  int candidateCount = 0;
+  int *candidates = HullMemAlloc(sizeof(int) * 2 * (size_t)(columnCount > 0 ? columnCount : 1));
+  for (int c = 0; c < columnCount; c++)
+  {
+    uint64_t first = atomic_load_explicit(&ctx.first[c], memory_order_relaxed);
+    if (first == HULL_KERNEL_EMPTY) continue;
+    uint64_t last = atomic_load_explicit(&ctx.last[c], memory_order_relaxed);
+    candidates[candidateCount++] = (int)(uint32_t)first;
+    if (last != first) candidates[candidateCount++] = (int)(uint32_t)last;
+  }
+  HullMemFree(ctx.last);
+  HullMemFree(ctx.first);
+  if (span == 0.0)
+  {
+    // At most one distinct point, it is its own hull
+    for (int i = 0; i < n && candidateCount == 0 && kernel->inputCount > 0; i++)
+    {
+      if (fIsFinite(v[i])) candidates[candidateCount++] = i;
+    }
+  }
+
+  // Column order would insert the candidates in one sweep, the spatial order keeps both builds fast
+  HullVec3 *points = HullMemAlloc(sizeof(HullVec3) * (size_t)(candidateCount > 0 ? candidateCount : 1));
+  for (int i = 0; i < candidateCount; i++)
+  {
+    points[i] = v[candidates[i]];
+  }
+  int *order = CreateHullSpatialOrder(points, candidateCount, threadCount);
+  int *ordered = HullMemAlloc(sizeof(int) * (size_t)(candidateCount > 0 ? candidateCount : 1));
+  for (int i = 0; i < candidateCount; i++)
+  {
+    ordered[i] = candidates[order[i]];
+    points[i] = v[ordered[i]];
+  }
+  HullMemFree(candidates);
+  HullMemFree(order);
+  candidates = ordered;
+  bool *used = HullMemAlloc(sizeof(bool) * (size_t)(candidateCount > 0 ? candidateCount : 1));
+  ConvexShape *shape = candidateCount >= 2 ? CreateConvexShapeEx(points, candidateCount, -1, HULL_ENGINE_CONFLICT) : NULL;
+  if (shape == NULL)
+  {
+    for (int i = 0; i < candidateCount; i++) used[i] = true;
+  }
+  else if (shape->edgeCount > 0)
+  {
+    // Collinear, the segment's ends are exact
+    used[shape->edges[0].indices[0]] = true;
+    used[shape->edges[0].indices[1]] = true;
+  }
+  else if (shape->triangleCount > 0)
+  {
+    // The other half of the error: a direction is within epsilon / 2 of a sampled one
+    fSampleDirections(shape, (int)ceil(2.0 * sqrt(2.0) / epsilon), used);
+  }
+  ClearConvexShape(shape);
+  HullMemFree(shape);
+
+  kernel->points = HullMemAlloc(sizeof(HullVec3) * (size_t)(candidateCount > 0 ? candidateCount : 1));
+  kernel->indices = HullMemAlloc(sizeof(int) * (size_t)(candidateCount > 0 ? candidateCount : 1));
+  for (int i = 0; i < candidateCount; i++)
+  {
+    if (!used[i]) continue;
+    kernel->points[kernel->count] = points[i];
+    kernel->indices[kernel->count++] = candidates[i];
+  }
+
+  HullMemFree(used);
+  HullMemFree(points);
+  HullMemFree(candidates);
+  HullTraceEnd();
+  return kernel;
+}
+
+void ClearHullKernel(HullKernel *kernel)
+{
+  if (kernel == NULL)
+  {
+    return;
+  }
+  HullMemFree(kernel->points);
+  kernel->points = NULL;
+  HullMemFree(kernel->indices);
+  kernel->indices = NULL;
+  kernel->count = 0;
+  kernel->inputCount = 0;
+}
@@ -0,0 +1,27 @@
+#ifndef HULL_KERNEL_H_
+#define HULL_KERNEL_H_
+#include "hull_core.h"
+
+// Finer kernels sample millions of directions, build the exact hull instead
+#define HULL_KERNEL_MIN_EPSILON 0.005f
+
+// Input points whose hull approximates the hull of all of them.
+typedef struct HullKernel {
+  int count;
+  HullVec3 *points;
+  int *indices;      // Kernel point -> input index
+  int inputCount;    // Finite input points
+  float epsilon;
+  float errorBound;  // epsilon times the bounding box diagonal
+} HullKernel;
+
+// Epsilon-kernel by direction sampling. One pass keeps the extreme points of every column of a grid along the
+// longest axis, then the exact hull of those is searched for its extreme point in each direction of a grid on
+// the faces of a cube, about 48 / epsilon^2 of them. The kernel size depends only on epsilon, not on n.
+// Every point of the input hull is within errorBound of the kernel's hull, which lies inside the input hull.
+// The column pass runs on threadCount threads (0 = every core). Points with a NaN or infinite coordinate are
+// ignored. NULL when epsilon is outside [HULL_KERNEL_MIN_EPSILON, 1].
+HullKernel *CreateHullKernel(const HullVec3 v[], int n, float epsilon, int threadCount);
+void ClearHullKernel(HullKernel *kernel);
+
+#endif
@@ -0,0 +1,191 @@
+#include "hull_order.h"
+#include "hull_parallel.h"
+#include "hull_trace.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define HULL_ORDER_ROUNDS 16
+#define HULL_ORDER_ROUND_BITS 4
+// Most Morton bits per axis, keys are the round above the Morton code
+#define HULL_ORDER_MAX_AXIS_BITS 20
+#define HULL_ORDER_DIGIT_BITS 11
+#define HULL_ORDER_DIGITS (1 << HULL_ORDER_DIGIT_BITS)
+// Points per block, every block counts its own digits so blocks can be sorted on different threads
+#define HULL_ORDER_BLOCK (1 << 16)
+
+typedef struct HullOrderContext {
+  const HullVec3 *v;
+  int n;
+  int axisBits;     // Morton bits per axis, a few more than n needs to tell the points apart
+  float low[3];
+  double scale[3];  // Bounding box -> [0, 2^axisBits)
+  uint64_t *keys;
+  int *indices;
+  uint64_t *nextKeys;
+  int *nextIndices;
+  int shift;        // Digit of the current pass
+  int *counts;      // HULL_ORDER_DIGITS per block: its count of every digit, then where the block writes it
+} HullOrderContext;
+
+// Spreads 20 bits to every third bit
+static uint64_t fSpreadBits(uint64_t x)
+{
+  x &= (1ULL << HULL_ORDER_MAX_AXIS_BITS) - 1;
+  x = (x | x << 32) & 0x001F00000000FFFFULL;
+  x = (x | x << 16) & 0x001F0000FF0000FFULL;
+  x = (x | x << 8) & 0x100F00F00F00F00FULL;
+  x = (x | x << 4) & 0x10C30C30C30C30C3ULL;
+  x = (x | x << 2) & 0x1249249249249249ULL;
+  return x;
+}
+
+// Round of a point from its index alone: the number of trailing one bits of a hash, counted down from the last
+static uint64_t fRoundOf(int index)
+{
+  uint32_t x = (uint32_t)index;
+  x ^= x >> 16;
+  x *= 0x7FEB352DU;
+  x ^= x >> 15;
+  x *= 0x846CA68BU;
+  x ^= x >> 16;
+  int ones = 0;
+  while (ones < HULL_ORDER_ROUNDS - 1 && (x >> ones & 1))
+  {
+    ones++;
+  }
+  return (uint64_t)(HULL_ORDER_ROUNDS - 1 - ones);
+}
+
+static void fKeyRange(void *context, int begin, int end)
+{
+  HullOrderContext *ctx = (HullOrderContext *)context;
+  const double top = (double)((1 << ctx->axisBits) - 1);
+  for (int i = begin; i < end; i++)
+  {
+    float coordinates[3] = { ctx->v[i].x, ctx->v[i].y, ctx->v[i].z };
+    uint64_t morton = 0;
+    for (int k = 0; k < 3; k++)
+    {
+      // Not finite coordinates go last in their round
+      double cell = isfinite(coordinates[k]) ? ((double)coordinates[k] - ctx->low[k]) * ctx->scale[k] : top;
+      morton |= fSpreadBits((uint64_t)fmin(fmax(cell, 0.0), top)) << k;
+    }
+    ctx->keys[i] = fRoundOf(i) << (3 * ctx->axisBits) | morton;
+    ctx->indices[i] = i;
+  }
+}
+
+static int fBlockEnd(const HullOrderContext *ctx, int block)
+{
+  return ctx->n - block * HULL_ORDER_BLOCK > HULL_ORDER_BLOCK ? (block + 1) * HULL_ORDER_BLOCK : ctx->n;
+}
+
+static void fCountBlocks(void *context, int begin, int end)
+{
+  HullOrderContext *ctx = (HullOrderContext *)context;
+  for (int block = begin; block < end; block++)
+  {
+    int *counts = ctx->counts + (size_t)block * HULL_ORDER_DIGITS;
+    memset(counts, 0, sizeof(int) * HULL_ORDER_DIGITS);
+    int last = fBlockEnd(ctx, block);
+    for (int i = block * HULL_ORDER_BLOCK; i < last; i++)
+    {
+      counts[ctx->keys[i] >> ctx->shift & (HULL_ORDER_DIGITS - 1)]++;
+    }
+  }
+}
+
+static void fScatterBlocks(void *context, int begin, int end)
+{
+  HullOrderContext *ctx = (HullOrderContext *)context;
+  for (int block = begin; block < end; block++)
+  {
+    int *next = ctx->counts + (size_t)block * HULL_ORDER_DIGITS;
+    int last = fBlockEnd(ctx, block);
+    for (int i = block * HULL_ORDER_BLOCK; i < last; i++)
+    {
+      int position = next[ctx->keys[i] >> ctx->shift & (HULL_ORDER_DIGITS - 1)]++;
+      ctx->nextKeys[position] = ctx->keys[i];
+      ctx->nextIndices[position] = ctx->indices[i];
+    }
+  }
+}
+
+int *CreateHullSpatialOrder(const HullVec3 v[], int n, int threadCount)
+{
+  HullTraceBegin("CreateHullSpatialOrder");
+  size_t size = (size_t)(n > 0 ? n : 1);
+  HullOrderContext ctx = { 0 };
+  ctx.v = v;
+  ctx.n = n;
+  // Finer codes would not change the order much, only cost sorting passes
+  ctx.axisBits = 3;
+  while (ctx.axisBits < HULL_ORDER_MAX_AXIS_BITS && 1LL << (3 * (ctx.axisBits - 2)) < n)
+  {
+    ctx.axisBits++;
+  }
+
+  // Bounding box of the finite points
+  float high[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for (int k = 0; k < 3; k++) ctx.low[k] = INFINITY;
+  for (int i = 0; i < n; i++)
+  {
+    float coordinates[3] = { v[i].x, v[i].y, v[i].z };
+    for (int k = 0; k < 3; k++)
+    {
+      if (!isfinite(coordinates[k])) continue;
+      ctx.low[k] = fminf(ctx.low[k], coordinates[k]);
+      high[k] = fmaxf(high[k], coordinates[k]);
+    }
+  }
+  for (int k = 0; k < 3; k++)
+  {
+    double span = (double)high[k] - ctx.low[k];
+    ctx.scale[k] = span > 0.0 ? (1 << ctx.axisBits) / span : 0.0;
+  }
+
+  ctx.keys = HullMemAlloc(sizeof(uint64_t) * size);
+  ctx.indices = HullMemAlloc(sizeof(int) * size);
+  ctx.nextKeys = HullMemAlloc(sizeof(uint64_t) * size);
+  ctx.nextIndices = HullMemAlloc(sizeof(int) * size);
+  HullParallelFor(n, threadCount, fKeyRange, &ctx);
+
+  // Least significant digit first, stable within and across blocks
+  int blockCount = (n + HULL_ORDER_BLOCK - 1) / HULL_ORDER_BLOCK;
+  ctx.counts = HullMemAlloc(sizeof(int) * HULL_ORDER_DIGITS * (size_t)(blockCount > 0 ? blockCount : 1));
+  for (ctx.shift = 0; ctx.shift < 3 * ctx.axisBits + HULL_ORDER_ROUND_BITS; ctx.shift += HULL_ORDER_DIGIT_BITS)
+  {
+    HullParallelForEx(blockCount, 1, threadCount, fCountBlocks, &ctx);
+    int position = 0;
+    bool sorted = false;
+    for (int digit = 0; digit < HULL_ORDER_DIGITS; digit++)
+    {
+      int first = position;
+      for (int block = 0; block < blockCount; block++)
+      {
+        int *count = &ctx.counts[(size_t)block * HULL_ORDER_DIGITS + digit];
+        int digits = *count;
+        *count = position;
+        position += digits;
+      }
+      // Every key has the same digit, the pass would not move anything
+      sorted |= position - first == n;
+    }
+    if (sorted) continue;
+    HullParallelForEx(blockCount, 1, threadCount, fScatterBlocks, &ctx);
+    uint64_t *keys = ctx.keys;
+    ctx.keys = ctx.nextKeys;
+    ctx.nextKeys = keys;
+    int *indices = ctx.indices;
+    ctx.indices = ctx.nextIndices;
+    ctx.nextIndices = indices;
+  }
+
+  HullMemFree(ctx.counts);
+  HullMemFree(ctx.nextIndices);
+  HullMemFree(ctx.nextKeys);
+  HullMemFree(ctx.keys);
+  HullTraceEnd();
+  return ctx.indices;
+}
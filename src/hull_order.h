@@ -0,0 +1,13 @@
+#ifndef HULL_ORDER_H_
+#define HULL_ORDER_H_
+#include "hull_core.h"
+
+// Insertion order with locality, a biased randomised insertion order: a hash of the index puts every point in
+// one of 16 rounds, the last round holding about half of the points and each earlier one half as many, and
+// each round is sorted along a 3D Morton curve. Sorting alone would insert the points in one sweep with nearly
+// all of them outside the growing hull, the rounds keep the expected work of a random order.
+// Returns order[i] = input index of the i-th point, free it with HullMemFree. The radix sort runs on threadCount
+// threads (0 = every core) and the order does not depend on the thread count.
+int *CreateHullSpatialOrder(const HullVec3 v[], int n, int threadCount);
+
+#endif
@@ -0,0 +1,220 @@
+#include "hull_parallel.h"
+#include "hull_core.h"
+#include "hull_trace.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#if !defined(_WIN32)
+#include <unistd.h>
+#endif
+
+#define HULL_PARALLEL_MAX_THREADS 256
+
+typedef struct HullParallelTask {
+  HullParallelBody body;
+  void *context;
+  int begin;
+  int end;
+} HullParallelTask;
+
+static void *fRunTask(void *arg)
+{
+  HullParallelTask *task = (HullParallelTask *)arg;
+  HullTraceBegin("parallelFor");
+  task->body(task->context, task->begin, task->end);
+  HullTraceEnd();
+  return NULL;
+}
+
+static void *fThreadMain(void *arg)
+{
+  // Threads only live for one loop, outside a capture they do not need a trace buffer
+  if (HullTraceIsRecording())
+  {
+    HullTraceSetThreadName("parallel");
+  }
+  return fRunTask(arg);
+}
+
+// Worker threads kept between loops: they sleep until the generation changes, worker w then runs tasks[w + 1]
+// when there is one. One loop at a time uses the pool, others fall back to threads of their own.
+typedef struct HullParallelPool {
+  pthread_mutex_t mutex;
+  pthread_cond_t wake;    // Workers wait for a new generation
+  pthread_cond_t done;    // The caller waits for pending to drop to 0
+  unsigned generation;
+  int workerCount;
+  bool full;              // A thread failed to start, the pool stays at workerCount
+  int taskCount;          // Tasks of this generation, the caller runs tasks[0]
+  int pending;            // Tasks of this generation still running on workers
+  HullParallelTask tasks[HULL_PARALLEL_MAX_THREADS];
+  // Generation when each worker was created, a worker that first runs after the next one began still joins it
+  unsigned created[HULL_PARALLEL_MAX_THREADS];
+} HullParallelPool;
+
+static HullParallelPool pool = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, PTHREAD_COND_INITIALIZER };
+static pthread_mutex_t poolInUse = PTHREAD_MUTEX_INITIALIZER;
+
+static void *fPoolMain(void *arg)
+{
+  int worker = (int)(intptr_t)arg;
+  pthread_mutex_lock(&pool.mutex);
+  unsigned seen = pool.created[worker];
+  for (;;)
+  {
+    while (pool.generation == seen) pthread_cond_wait(&pool.wake, &pool.mutex);
+    seen = pool.generation;
+    if (worker + 1 >= pool.taskCount) continue;
+    HullParallelTask task = pool.tasks[worker + 1];
+    pthread_mutex_unlock(&pool.mutex);
+
+    // A capture can start while the thread sleeps, it is named on its first task of one
+    if (HullTraceIsRecording())
+    {
+      HullTraceSetThreadName("parallel");
+    }
+    fRunTask(&task);
+
+    pthread_mutex_lock(&pool.mutex);
+    if (--pool.pending == 0) pthread_cond_signal(&pool.done);
+  }
+  return NULL;
+}
+
+// Grows the pool towards workerCount threads and returns how many it has. Called with poolInUse held.
+static int fGrowPool(int workerCount)
+{
+  pthread_mutex_lock(&pool.mutex);
+  int failed = 0;
+  while (pool.workerCount < workerCount && !pool.full)
+  {
+    pthread_t thread;
+    pool.created[pool.workerCount] = pool.generation;
+    if (pthread_create(&thread, NULL, fPoolMain, (void *)(intptr_t)pool.workerCount) != 0)
+    {
+      failed = workerCount - pool.workerCount;
+      pool.full = true;
+      break;
+    }
+    pthread_detach(thread);
+    pool.workerCount++;
+  }
+  int available = pool.workerCount;
+  pthread_mutex_unlock(&pool.mutex);
+  if (failed > 0)
+  {
+    HullLog(HULL_LOG_WARNING, "PARALLEL: %d of %d threads failed to start, the caller runs their ranges from now on", failed, workerCount);
+  }
+  return available;
+}
+
+// Threads of its own for a loop that finds the pool busy, joined at the end
+static void fSpawnAndJoin(HullParallelTask *tasks, int threadCount)
+{
+  pthread_t threads[HULL_PARALLEL_MAX_THREADS];
+  // The calling thread takes the first range itself, and every range whose thread did not start
+  bool started[HULL_PARALLEL_MAX_THREADS] = { false };
+  for (int t = 1; t < threadCount; t++)
+  {
+    started[t] = pthread_create(&threads[t], NULL, fThreadMain, &tasks[t]) == 0;
+  }
+  fRunTask(&tasks[0]);
+  int failed = 0;
+  for (int t = 1; t < threadCount; t++)
+  {
+    if (!started[t])
+    {
+      fRunTask(&tasks[t]);
+      failed++;
+    }
+  }
+  if (failed > 0)
+  {
+    HullLog(HULL_LOG_WARNING, "PARALLEL: %d of %d threads failed to start, the caller ran their ranges", failed, threadCount - 1);
+  }
+  for (int t = 1; t < threadCount; t++)
+  {
+    if (started[t]) pthread_join(threads[t], NULL);
+  }
+}
+
+int HullGetThreadCount(void)
+{
+#if defined(_WIN32)
+  // Provided by winpthreads
+  int count = pthread_num_processors_np();
+#else
+  int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+  return count > 0 ? count : 1;
+}
+
+void HullParallelFor(int count, int threadCount, HullParallelBody body, void *context)
+{
+  HullParallelForEx(count, HULL_PARALLEL_MIN_ITEMS, threadCount, body, context);
+}
+
+void HullParallelForEx(int count, int minItems, int threadCount, HullParallelBody body, void *context)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+  if (threadCount <= 0)
+  {
+    threadCount = HullGetThreadCount();
+  }
+  if (threadCount > HULL_PARALLEL_MAX_THREADS)
+  {
+    threadCount = HULL_PARALLEL_MAX_THREADS;
+  }
+  if (minItems > 1 && threadCount > count / minItems)
+  {
+    threadCount = count / minItems;
+  }
+  if (threadCount > count)
+  {
+    threadCount = count;
+  }
+  if (threadCount <= 1)
+  {
+    body(context, 0, count);
+    return;
+  }
+
+  HullParallelTask tasks[HULL_PARALLEL_MAX_THREADS];
+  for (int t = 0; t < threadCount; t++)
+  {
+    tasks[t] = (HullParallelTask){
+      body,
+      context,
+      (int)((long long)count * t / threadCount),
+      (int)((long long)count * (t + 1) / threadCount)
+    };
+  }
+  // A nested loop, or one on another thread while the pool is busy, must not wait for the pool
+  if (pthread_mutex_trylock(&poolInUse) != 0)
+  {
+    fSpawnAndJoin(tasks, threadCount);
+    return;
+  }
+  int workers = fGrowPool(threadCount - 1);
+  pthread_mutex_lock(&pool.mutex);
+  pool.taskCount = workers + 1 < threadCount ? workers + 1 : threadCount;
+  memcpy(pool.tasks, tasks, sizeof(HullParallelTask) * (size_t)pool.taskCount);
+  pool.pending = pool.taskCount - 1;
+  pool.generation++;
+  int pooled = pool.taskCount;
+  pthread_cond_broadcast(&pool.wake);
+  pthread_mutex_unlock(&pool.mutex);
+
+  // The caller takes the first range and those without a worker
+  fRunTask(&tasks[0]);
+  for (int t = pooled; t < threadCount; t++) fRunTask(&tasks[t]);
+
+  pthread_mutex_lock(&pool.mutex);
+  while (pool.pending > 0) pthread_cond_wait(&pool.done, &pool.mutex);
+  pthread_mutex_unlock(&pool.mutex);
+  pthread_mutex_unlock(&poolInUse);
+}
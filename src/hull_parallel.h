@@ -0,0 +1,18 @@
+#ifndef HULL_PARALLEL_H_
+#define HULL_PARALLEL_H_
+
+// Below this many items a parallel loop runs on the calling thread
+#define HULL_PARALLEL_MIN_ITEMS 4096
+
+// Processes items [begin, end)
+typedef void (*HullParallelBody)(void *context, int begin, int end);
+
+int HullGetThreadCount(void);
+// Splits [0, count) into one contiguous range per thread, threadCount <= 0 uses every core. The caller runs the
+// first range, the others run on worker threads that are started on first use and kept for later loops. A loop
+// started while another one holds the workers, nested or from another thread, starts and joins its own.
+void HullParallelFor(int count, int threadCount, HullParallelBody body, void *context);
+// Same with at least minItems items per thread instead of HULL_PARALLEL_MIN_ITEMS, for loops over few heavy items
+void HullParallelForEx(int count, int minItems, int threadCount, HullParallelBody body, void *context);
+
+#endif
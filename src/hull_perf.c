@@ -0,0 +1,149 @@
+#include "hull_perf.h"
+#include <string.h>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char *counterNames[HULL_PERF_COUNTER_COUNT] = {
+  "cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"
+};
+
+#if defined(__linux__)
+static int fOpenCounter(HullPerfCounter counter)
+{
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.disabled = 1;
+  attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2, the hull code is user space only
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+  switch (counter)
+  {
+    case HULL_PERF_CYCLES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CPU_CYCLES;
+      break;
+    case HULL_PERF_INSTRUCTIONS:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+      break;
+    case HULL_PERF_L1D_MISSES:
+      attr.type = PERF_TYPE_HW_CACHE;
+      attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+      break;
+    case HULL_PERF_LLC_MISSES:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_CACHE_MISSES;
+      break;
+    default:
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+      break;
+  }
+
+  // Calling thread, any CPU
+  int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+  ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+  return fd;
+}
+#endif
+
+HullPerf *HullPerfOpen(void)
+{
+  HullPerf *perf = HullMemAlloc(sizeof(HullPerf));
+  for (int i = 0; i < HULL_PERF_COUNTER_COUNT; i++)
+  {
+#if defined(__linux__)
+    perf->fds[i] = fOpenCounter((HullPerfCounter)i);
+#else
+    perf->fds[i] = -1;
+#endif
+    perf->availableCount += perf->fds[i] >= 0;
+  }
+  return perf;
+}
+
+bool HullPerfAvailable(HullPerf *perf, HullPerfCounter counter)
+{
+  return perf != NULL && counter >= 0 && counter < HULL_PERF_COUNTER_COUNT && perf->fds[counter] >= 0;
+}
+
+void HullPerfRead(HullPerf *perf, HullPerfSample *sample)
+{
+  for (int i = 0; i < HULL_PERF_COUNTER_COUNT; i++)
+  {
+    sample->values[i] = HULL_PERF_UNAVAILABLE;
+#if defined(__linux__)
+    if (perf == NULL || perf->fds[i] < 0)
+    {
+      continue;
+    }
+    // value, time enabled, time running
+    unsigned long long data[3];
+    if (read(perf->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0)
+    {
+      continue;
+    }
+    double scale = data[2] < data[1] ? (double)data[1] / (double)data[2] : 1.0;
+    sample->values[i] = (long long)(data[0] * scale);
+#endif
+  }
+}
+
+void HullPerfClose(HullPerf *perf)
+{
+  if (perf == NULL)
+  {
+    return;
+  }
+#if defined(__linux__)
+  for (int i = 0; i < HULL_PERF_COUNTER_COUNT; i++)
+  {
+    if (perf->fds[i] >= 0)
+    {
+      close(perf->fds[i]);
+    }
+  }
+#endif
+  HullMemFree(perf);
+}
+
+void HullPerfAccumulate(HullPerfSample *to, const HullPerfSample *start, const HullPerfSample *end)
+{
+  for (int i = 0; i < HULL_PERF_COUNTER_COUNT; i++)
+  {
+    if (start->values[i] == HULL_PERF_UNAVAILABLE || end->values[i] == HULL_PERF_UNAVAILABLE)
+    {
+      to->values[i] = HULL_PERF_UNAVAILABLE;
+      continue;
+    }
+    to->values[i] = (to->values[i] == HULL_PERF_UNAVAILABLE ? 0 : to->values[i]) + end->values[i] - start->values[i];
+  }
+}
+
+void HullPerfSampleClear(HullPerfSample *sample)
+{
+  for (int i = 0; i < HULL_PERF_COUNTER_COUNT; i++)
+  {
+    sample->values[i] = HULL_PERF_UNAVAILABLE;
+  }
+}
+
+const char *GetHullPerfCounterName(HullPerfCounter counter)
+{
+  if (counter < 0 || counter >= HULL_PERF_COUNTER_COUNT)
+  {
+    return "unknown";
+  }
+  return counterNames[counter];
+}
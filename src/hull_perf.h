@@ -0,0 +1,41 @@
+#ifndef HULL_PERF_H_
+#define HULL_PERF_H_
+#include "hull_core.h"
+
+// Hardware performance counters of the calling thread, through Linux perf_event_open.
+// Counters the kernel, the CPU or the permissions do not allow are left out,
+// on other systems nothing is available and every read returns HULL_PERF_UNAVAILABLE.
+
+#define HULL_PERF_UNAVAILABLE -1
+
+typedef enum HullPerfCounter {
+  HULL_PERF_CYCLES = 0,
+  HULL_PERF_INSTRUCTIONS,
+  HULL_PERF_L1D_MISSES,   // L1 data cache read misses
+  HULL_PERF_LLC_MISSES,   // Last level cache misses
+  HULL_PERF_BRANCH_MISSES,
+  HULL_PERF_COUNTER_COUNT
+} HullPerfCounter;
+
+typedef struct HullPerfSample {
+  long long values[HULL_PERF_COUNTER_COUNT]; // HULL_PERF_UNAVAILABLE for counters that are not open
+} HullPerfSample;
+
+typedef struct HullPerf {
+  int fds[HULL_PERF_COUNTER_COUNT]; // -1 when the counter could not be opened
+  int availableCount;
+} HullPerf;
+
+// Never NULL, check availableCount or HullPerfAvailable to see whether anything is counted
+HullPerf *HullPerfOpen(void);
+bool HullPerfAvailable(HullPerf *perf, HullPerfCounter counter);
+// Counts since HullPerfOpen, scaled when the kernel had to multiplex the counters
+void HullPerfRead(HullPerf *perf, HullPerfSample *sample);
+void HullPerfClose(HullPerf *perf);
+
+// to = to + (end - start), unavailable counters stay unavailable
+void HullPerfAccumulate(HullPerfSample *to, const HullPerfSample *start, const HullPerfSample *end);
+void HullPerfSampleClear(HullPerfSample *sample);
+const char *GetHullPerfCounterName(HullPerfCounter counter);
+
+#endif
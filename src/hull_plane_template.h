@@ -0,0 +1,39 @@
+// Orientation plane filter for one inexact scalar type, hull_predicates.h includes this once per scalar.
+// No include guard on purpose, every instantiation is generated at compile time from these parameters:
+//   HULL_P_V        point type
+//   HULL_P_T        scalar type of the extent
+//   HULL_P_BOUND    error bound of normal . p - offset in units of eps * extent * permanent
+//   HULL_P_FN(op)   name of HullOrientPlane##op for this scalar
+// Every parameter is undefined again at the end.
+
+// extent must bound the absolute coordinates of a, b, c and of every point tested against the plane
+static inline void HULL_P_FN(Init)(HullOrientPlane *plane, HULL_P_V a, HULL_P_V b, HULL_P_V c, HULL_P_T extent)
+{
+  double ux = (double)b.x - a.x, uy = (double)b.y - a.y, uz = (double)b.z - a.z;
+  double vx = (double)c.x - a.x, vy = (double)c.y - a.y, vz = (double)c.z - a.z;
+
+  double uyvz = uy * vz, uzvy = uz * vy;
+  double uzvx = uz * vx, uxvz = ux * vz;
+  double uxvy = ux * vy, uyvx = uy * vx;
+
+  plane->normal[0] = uyvz - uzvy;
+  plane->normal[1] = uzvx - uxvz;
+  plane->normal[2] = uxvy - uyvx;
+  plane->offset = a.x * plane->normal[0] + a.y * plane->normal[1] + a.z * plane->normal[2];
+
+  double permanent = (fabs(uyvz) + fabs(uzvy)) + (fabs(uzvx) + fabs(uxvz)) + (fabs(uxvy) + fabs(uyvx));
+  plane->bound = HULL_P_BOUND * HULL_ORIENT_EPSILON * extent * permanent;
+}
+
+// Orientation of p against the plane, returns false when rounding could have flipped the sign of *det.
+// A single comparison on the magnitude that almost always passes, the sign branch is left to the caller.
+static inline bool HULL_P_FN(Filter)(const HullOrientPlane *plane, HULL_P_V p, double *det)
+{
+  *det = p.x * plane->normal[0] + p.y * plane->normal[1] + p.z * plane->normal[2] - plane->offset;
+  return fabs(*det) > plane->bound;
+}
+
+#undef HULL_P_V
+#undef HULL_P_T
+#undef HULL_P_BOUND
+#undef HULL_P_FN
@@ -0,0 +1,1050 @@
+#include "hull_polyhedron.h"
+#include "hull_predicates.h"
+#include "hull_trace.h"
+#include "dynamic_array.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Whether a boundary vertex is a corner of the faces it is on
+typedef enum HullMergeCorner {
+  HULL_MERGE_UNDECIDED = 0,
+  HULL_MERGE_KEEP,
+  HULL_MERGE_DROP
+} HullMergeCorner;
+
+typedef struct HullMergeVertex {
+  HullVec3 position;
+  int index;
+} HullMergeVertex;
+
+// Corner of a face seen along its normal
+typedef struct HullMergePoint {
+  double x, y;
+} HullMergePoint;
+
+// Edge of a piece of a face, key is lower * cornerCount + higher corner so that both sides sort together
+typedef struct HullMergeEdge {
+  long long key;
+  int half;
+} HullMergeEdge;
+
+typedef struct HullMergeSeed {
+  double area;
+  int triangle;
+} HullMergeSeed;
+
+// Scratch of one merge, the polyhedron arrays grow while faces are emitted
+typedef struct HullMerge {
+  const ConvexShape *shape;
+  int *neighbours;    // Triangle across edge k (indices[k] -> indices[k + 1]) at 3 * t + k, -1 on an open edge
+  HullVec3d *normals; // Unit normal per triangle, zero when the triangle has no area
+  bool *flat;         // Triangle without area
+  int *region;        // Facet, later face, of every triangle, -1 while unassigned
+  int *members;       // Triangles of the facet being grown, later all triangles sorted by face
+  int *outgoing;      // Next vertex along the boundary being looked at, -1 off it
+  int *across;        // Triangle across the boundary edge leaving each vertex
+  int *canonical;     // Lowest index at the same position, -1 for vertices no triangle uses
+  int *touchCount;    // Faces meeting at each canonical vertex, up to 3
+  int *firstFace;     // The first two of them
+  int *secondFace;
+  unsigned char *corner; // HullMergeCorner of each canonical vertex
+  int *loop;          // Boundary of the region being looked at
+  int *loopAcross;    // Triangle across each of its edges
+  int *corners;       // Corners of the face being emitted
+  int *stack;         // Chain ends still to simplify
+  // Facets are the exactly coplanar regions, merging within a tolerance works on whole facets
+  int *facetSeed;     // Largest triangle of every facet, its plane is the facet's
+  int *facetFirst;    // Boundary of facet f is facetLoop[facetFirst[f]] .. facetLoop[facetFirst[f + 1] - 1]
+  int *facetLoop;
+  int *facetAcross;   // Facet across each boundary edge, -1 for none
+  int *facetFace;     // Face of every facet, -1 while unassigned
+  bool *facetAlone;   // Facet kept out of merging, at an inward corner of a face that could not be cut
+  int *facetOf;       // Facet of every triangle, -1 for zero area triangles no facet reached
+  int *visited;       // facet + 1 of the last facet boundary through each vertex
+  int *faceSeed;      // Largest triangle of every face, the face's plane is its plane
+  unsigned char *bent; // 1 for a face that bends inwards and could not be cut, 2 once a facet of it is alone
+  bool *inward;       // Canonical vertex where an emitted face bends inwards
+  int faceCapacity;
+  int planeCapacity;
+  int indexCapacity;
+} HullMerge;
+
+static int fCompareVertexPositions(const HullVec3 *a, const HullVec3 *b)
+{
+  if (a->x != b->x) return a->x < b->x ? -1 : 1;
+  if (a->y != b->y) return a->y < b->y ? -1 : 1;
+  if (a->z != b->z) return a->z < b->z ? -1 : 1;
+  return 0;
+}
+
+// By position, then index so that the first of coincident vertices is the lowest index
+static int fCompareVertices(const void *a, const void *b)
+{
+  const HullMergeVertex *x = a, *y = b;
+  int order = fCompareVertexPositions(&x->position, &y->position);
+  return order != 0 ? order : x->index - y->index;
+}
+
+static int fCompareSeeds(const void *a, const void *b)
+{
+  const HullMergeSeed *x = a, *y = b;
+  // Largest area first, the big triangles give the best planes to grow from
+  if (x->area != y->area) return x->area < y->area ? 1 : -1;
+  return x->triangle - y->triangle;
+}
+
+static int fCompareEdges(const void *a, const void *b)
+{
+  const HullMergeEdge *x = a, *y = b;
+  if (x->key != y->key) return x->key < y->key ? -1 : 1;
+  return x->half - y->half;
+}
+
+static HullVec3d fVertex(const HullMerge *merge, int index)
+{
+  return HullVec3ToDouble(merge->shape->vertices[index]);
+}
+
+// Edges bucketed by the vertex they leave, the reverse of an edge is looked up among the few leaving its end
+static void fFindNeighbours(HullMerge *merge)
+{
+  const ConvexShape *shape = merge->shape;
+  int edgeCount = shape->triangleCount * 3;
+  int *firstEdge = HullMemAlloc(sizeof(int) * (size_t)(shape->vertexCount + 1));
+  int *edgeTriangle = HullMemAlloc(sizeof(int) * (size_t)(edgeCount > 0 ? edgeCount : 1));
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    for (int k = 0; k < 3; k++) firstEdge[shape->triangles[t].indices[k] + 1]++;
+  }
+  for (int v = 0; v < shape->vertexCount; v++) firstEdge[v + 1] += firstEdge[v];
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    for (int k = 0; k < 3; k++) edgeTriangle[firstEdge[shape->triangles[t].indices[k]]++] = 3 * t + k;
+  }
+  // Filling moved every start to the next vertex's
+  for (int v = shape->vertexCount; v > 0; v--) firstEdge[v] = firstEdge[v - 1];
+  firstEdge[0] = 0;
+
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int from = shape->triangles[t].indices[k], to = shape->triangles[t].indices[(k + 1) % 3];
+      merge->neighbours[3 * t + k] = -1;
+      for (int e = firstEdge[to]; e < firstEdge[to + 1]; e++)
+      {
+        int reverse = edgeTriangle[e];
+        if (shape->triangles[reverse / 3].indices[(reverse % 3 + 1) % 3] != from) continue;
+        merge->neighbours[3 * t + k] = reverse / 3;
+        break;
+      }
+    }
+  }
+  HullMemFree(edgeTriangle);
+  HullMemFree(firstEdge);
+}
+
+// Floods the triangles exactly coplanar with the seed into facet, returns how many there are in merge->members
+static int fGrowFacet(HullMerge *merge, int seed, int facet)
+{
+  const ConvexShape *shape = merge->shape;
+  const int *seedIndices = shape->triangles[seed].indices;
+  HullVec3 a = shape->vertices[seedIndices[0]], b = shape->vertices[seedIndices[1]], c = shape->vertices[seedIndices[2]];
+  int count = 0;
+  merge->region[seed] = facet;
+  merge->members[count++] = seed;
+  for (int i = 0; i < count; i++)
+  {
+    int t = merge->members[i];
+    for (int k = 0; k < 3; k++)
+    {
+      int neighbour = merge->neighbours[3 * t + k];
+      if (neighbour < 0 || merge->region[neighbour] >= 0) continue;
+      // Coplanar but facing the other way happens on flat hulls, the two sides must stay apart
+      if (!merge->flat[neighbour] && HullVec3dDotProduct(merge->normals[seed], merge->normals[neighbour]) <= 0.0) continue;
+      // The shared edge is on the plane already, only the far corner is left to test
+      const int *indices = shape->triangles[neighbour].indices;
+      int from = shape->triangles[t].indices[k], to = shape->triangles[t].indices[(k + 1) % 3];
+      int apex = indices[0] != from && indices[0] != to ? indices[0] : indices[1] != from && indices[1] != to ? indices[1] : indices[2];
+      if (HullOrient3d(a, b, c, shape->vertices[apex]) != 0.0) continue;
+      merge->region[neighbour] = facet;
+      merge->members[count++] = neighbour;
+    }
+  }
+  return count;
+}
+
+static void fReleaseRegion(HullMerge *merge, int count)
+{
+  for (int i = 0; i < count; i++) merge->region[merge->members[i]] = -1;
+}
+
+// Squared distance of b from the segment between a and c, symmetric in a and c
+static double fSegmentDistanceSquared(const HullMerge *merge, int a, int b, int c)
+{
+  if (a > c)
+  {
+    int swap = a;
+    a = c;
+    c = swap;
+  }
+  HullVec3d ab = HullVec3dSubtract(fVertex(merge, b), fVertex(merge, a));
+  HullVec3d ac = HullVec3dSubtract(fVertex(merge, c), fVertex(merge, a));
+  double along = HullVec3dDotProduct(ab, ac);
+  double lengthSquared = HullVec3dDotProduct(ac, ac);
+  if (along <= 0.0 || lengthSquared == 0.0) return HullVec3dDotProduct(ab, ab);
+  if (along >= lengthSquared)
+  {
+    HullVec3d cb = HullVec3dSubtract(ab, ac);
+    return HullVec3dDotProduct(cb, cb);
+  }
+  HullVec3d cross = HullVec3dCrossProduct(ab, ac);
+  return HullVec3dDotProduct(cross, cross) / lengthSquared;
+}
+
+// Whether b lies on the segment between a and c: exactly for tolerance 0, otherwise within tolerance.
+// A point on the line but outside the segment is a spike in the boundary, not a straight corner.
+static bool fOnSegment(const HullMerge *merge, int a, int b, int c, float tolerance)
+{
+  if (tolerance == 0.0f)
+  {
+    if (!HullCollinear(merge->shape->vertices[a], merge->shape->vertices[b], merge->shape->vertices[c])) return false;
+    HullVec3d ab = HullVec3dSubtract(fVertex(merge, b), fVertex(merge, a));
+    HullVec3d bc = HullVec3dSubtract(fVertex(merge, c), fVertex(merge, b));
+    return HullVec3dDotProduct(ab, bc) >= 0.0;
+  }
+  return fSegmentDistanceSquared(merge, a, b, c) <= (double)tolerance * tolerance;
+}
+
+// Walks the boundary of the region's triangles into merge->loop, every vertex on it included, and the
+// triangles across it into merge->loopAcross. Returns the vertex count, 0 when it is not one simple loop.
+static int fBoundaryLoop(HullMerge *merge, const int *members, int count, int region)
+{
+  const ConvexShape *shape = merge->shape;
+  int edgeCount = 0;
+  int start = -1;
+  bool simple = true;
+  for (int i = 0; i < count; i++)
+  {
+    int t = members[i];
+    for (int k = 0; k < 3; k++)
+    {
+      int neighbour = merge->neighbours[3 * t + k];
+      if (neighbour >= 0 && merge->region[neighbour] == region) continue;
+      int from = shape->triangles[t].indices[k];
+      // Two boundary edges leaving one vertex: the region touches itself there
+      if (merge->outgoing[from] >= 0) simple = false;
+      merge->outgoing[from] = shape->triangles[t].indices[(k + 1) % 3];
+      merge->across[from] = neighbour;
+      start = from;
+      edgeCount++;
+    }
+  }
+
+  // A second loop means a hole, the walk from one boundary edge must cover all of them
+  int loopCount = 0;
+  if (start >= 0 && simple)
+  {
+    int vertex = start;
+    do
+    {
+      merge->loopAcross[loopCount] = merge->across[vertex];
+      merge->loop[loopCount++] = vertex;
+      vertex = merge->outgoing[vertex];
+    } while (vertex >= 0 && vertex != start && loopCount <= edgeCount);
+    if (vertex != start || loopCount != edgeCount) loopCount = 0;
+  }
+
+  // Reset only what was set
+  for (int i = 0; i < count; i++)
+  {
+    int t = members[i];
+    for (int k = 0; k < 3; k++) merge->outgoing[shape->triangles[t].indices[k]] = -1;
+  }
+  return loopCount;
+}
+
+// Whether the boundary p -> q -> r turns inwards at q seen along normal, or doubles back along its line
+static bool fInwardCorner(const HullMerge *merge, HullVec3d normal, int p, int q, int r)
+{
+  HullVec3d pq = HullVec3dSubtract(fVertex(merge, q), fVertex(merge, p));
+  HullVec3d qr = HullVec3dSubtract(fVertex(merge, r), fVertex(merge, q));
+  double turn = HullVec3dDotProduct(HullVec3dCrossProduct(pq, qr), normal);
+  return turn < 0.0 || (turn == 0.0 && HullVec3dDotProduct(pq, qr) < 0.0);
+}
+
+// Adds facet g to the face grown from seed when it faces the same way, every corner of it lies within tolerance
+// of the seed's plane, which is the face's, and the face stays a simple polygon. The face's boundary is the
+// outgoing list, g must share one run of edges with it and the rest of g's boundary replaces that run.
+// The face may bend inwards meanwhile, it could not take the vertices inside it otherwise: fEmitFaces cuts it.
+static bool fTryAddFacet(HullMerge *merge, int seed, int g, float tolerance, int *boundaryVertex)
+{
+  const int *loop = merge->facetLoop + merge->facetFirst[g];
+  int n = merge->facetFirst[g + 1] - merge->facetFirst[g];
+  if (merge->facetAlone[g]) return false;
+  if (HullVec3dDotProduct(merge->normals[seed], merge->normals[merge->facetSeed[g]]) <= 0.0) return false;
+  HullVec3d normal = merge->normals[seed];
+  double offset = HullVec3dDotProduct(normal, fVertex(merge, merge->shape->triangles[seed].indices[0]));
+  for (int i = 0; i < n; i++)
+  {
+    if (fabs(HullVec3dDotProduct(normal, fVertex(merge, loop[i])) - offset) > tolerance) return false;
+  }
+
+  // Edge i, loop[i] -> loop[i + 1], is shared when the face's boundary runs it the other way
+  int sharedCount = 0, start = -1;
+  for (int i = 0; i < n; i++)
+  {
+    bool shared = merge->outgoing[loop[(i + 1) % n]] == loop[i];
+    bool previousShared = merge->outgoing[loop[i]] == loop[(i + n - 1) % n];
+    sharedCount += shared;
+    if (shared && !previousShared) start = i;
+  }
+  if (start < 0 || sharedCount == n) return false;
+  int run = 0;
+  while (merge->outgoing[loop[(start + run + 1) % n]] == loop[(start + run) % n]) run++;
+  if (run != sharedCount) return false;
+
+  // The face's boundary goes loop[end] -> ... -> loop[start] -> after, the part in between goes away
+  int end = (start + run) % n;
+  int after = merge->outgoing[loop[start]];
+  if (after == loop[end]) return false;
+  for (int i = (end + 1) % n; i != start; i = (i + 1) % n)
+  {
+    if (merge->outgoing[loop[i]] >= 0) return false;
+  }
+
+  for (int i = (start + 1) % n; i != end; i = (i + 1) % n)
+  {
+    merge->outgoing[loop[i]] = -1;
+  }
+  for (int i = end; i != start; i = (i + 1) % n)
+  {
+    merge->outgoing[loop[i]] = loop[(i + 1) % n];
+  }
+  *boundaryVertex = loop[start];
+  return true;
+}
+
+// Keeps the facet's boundary for merging, on canonical vertices so that faces also meet across coincident
+// ones. A boundary that passes a position twice cannot be merged, the facet is stored without one.
+static void fStoreFacet(HullMerge *merge, int facet, int seed, int loopCount)
+{
+  int first = merge->facetFirst[facet];
+  int *loop = merge->facetLoop + first;
+  int *across = merge->facetAcross + first;
+  int count = 0;
+  for (int i = 0; i < loopCount; i++)
+  {
+    // The edge leaving a run of coincident vertices leaves from its last one
+    int v = merge->canonical[merge->loop[i]];
+    if (count > 0 && loop[count - 1] == v)
+    {
+      across[count - 1] = merge->loopAcross[i];
+      continue;
+    }
+    loop[count] = v;
+    across[count++] = merge->loopAcross[i];
+  }
+  while (count > 1 && loop[count - 1] == loop[0]) count--;
+
+  bool simple = count >= 3;
+  for (int i = 0; i < count; i++)
+  {
+    if (merge->visited[loop[i]] == facet + 1) simple = false;
+    merge->visited[loop[i]] = facet + 1;
+  }
+  merge->facetSeed[facet] = seed;
+  merge->facetFirst[facet + 1] = first + (simple ? count : 0);
+}
+
+// Merges neighbouring facets into face, starting from facet seedFacet
+static void fGrowFace(HullMerge *merge, int seedFacet, int face, float tolerance)
+{
+  int seed = merge->facetSeed[seedFacet];
+  const int *loop = merge->facetLoop + merge->facetFirst[seedFacet];
+  int n = merge->facetFirst[seedFacet + 1] - merge->facetFirst[seedFacet];
+  merge->facetFace[seedFacet] = face;
+  merge->faceSeed[face] = seed;
+  if (n == 0 || merge->facetAlone[seedFacet]) return;
+  for (int i = 0; i < n; i++) merge->outgoing[loop[i]] = loop[(i + 1) % n];
+  int boundaryVertex = loop[0];
+
+  // Facets waiting to be spread from, members is free at this point
+  int *queue = merge->members;
+  int count = 0;
+  queue[count++] = seedFacet;
+  for (int i = 0; i < count; i++)
+  {
+    int facet = queue[i];
+    for (int k = merge->facetFirst[facet]; k < merge->facetFirst[facet + 1]; k++)
+    {
+      int g = merge->facetAcross[k];
+      if (g < 0 || merge->facetFace[g] >= 0) continue;
+      if (!fTryAddFacet(merge, seed, g, tolerance, &boundaryVertex)) continue;
+      merge->facetFace[g] = face;
+      queue[count++] = g;
+    }
+  }
+
+  int vertex = boundaryVertex;
+  do
+  {
+    int next = merge->outgoing[vertex];
+    merge->outgoing[vertex] = -1;
+    vertex = next;
+  } while (vertex >= 0);
+}
+
+// Lowest index of every position used by a triangle, duplicate input points can leave coincident hull
+// vertices. Faces use these, so that neighbouring faces share their corners by index.
+static void fFindCanonical(HullMerge *merge)
+{
+  const ConvexShape *shape = merge->shape;
+  HullMergeVertex *used = HullMemAlloc(sizeof(HullMergeVertex) * (size_t)(shape->vertexCount > 0 ? shape->vertexCount : 1));
+  int usedCount = 0;
+  for (int v = 0; v < shape->vertexCount; v++) merge->canonical[v] = -1;
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int index = shape->triangles[t].indices[k];
+      if (merge->canonical[index] < 0) used[usedCount++] = (HullMergeVertex){ shape->vertices[index], index };
+      merge->canonical[index] = index;
+    }
+  }
+  qsort(used, usedCount, sizeof(HullMergeVertex), fCompareVertices);
+  for (int i = 1; i < usedCount; i++)
+  {
+    if (fCompareVertexPositions(&used[i - 1].position, &used[i].position) == 0)
+    {
+      merge->canonical[used[i].index] = merge->canonical[used[i - 1].index];
+    }
+  }
+  HullMemFree(used);
+}
+
+// How many faces meet at every canonical vertex, counted up to 3
+static void fCountFaces(HullMerge *merge)
+{
+  const ConvexShape *shape = merge->shape;
+  for (int t = 0; t < shape->triangleCount; t++)
+  {
+    int face = merge->region[t];
+    if (face < 0) continue;
+    for (int k = 0; k < 3; k++)
+    {
+      int v = merge->canonical[shape->triangles[t].indices[k]];
+      if (merge->touchCount[v] == 0)
+      {
+        merge->firstFace[v] = face;
+        merge->touchCount[v] = 1;
+      }
+      else if (merge->touchCount[v] == 1 && merge->firstFace[v] != face)
+      {
+        merge->secondFace[v] = face;
+        merge->touchCount[v] = 2;
+      }
+      else if (merge->touchCount[v] == 2 && merge->firstFace[v] != face && merge->secondFace[v] != face)
+      {
+        merge->touchCount[v] = 3;
+      }
+    }
+  }
+}
+
+// Douglas-Peucker over the loop from corner `from` to corner `to`: keeps the farthest vertex off the line
+// between two kept ones until every dropped vertex is on the segment, within tolerance
+static void fSimplifyChain(HullMerge *merge, const int *loop, int loopCount, int from, int to, float tolerance)
+{
+  int stackCount = 0;
+  merge->stack[stackCount++] = from;
+  merge->stack[stackCount++] = to;
+  while (stackCount > 0)
+  {
+    int end = merge->stack[--stackCount];
+    int begin = merge->stack[--stackCount];
+    int farthest = -1;
+    double farthestDistance = -1.0;
+    for (int i = (begin + 1) % loopCount; i != end; i = (i + 1) % loopCount)
+    {
+      if (fOnSegment(merge, loop[begin], loop[i], loop[end], tolerance)) continue;
+      double distance = fSegmentDistanceSquared(merge, loop[begin], loop[i], loop[end]);
+      if (distance > farthestDistance)
+      {
+        farthest = i;
+        farthestDistance = distance;
+      }
+    }
+    if (farthest < 0)
+    {
+      for (int i = (begin + 1) % loopCount; i != end; i = (i + 1) % loopCount) merge->corner[loop[i]] = HULL_MERGE_DROP;
+      continue;
+    }
+    merge->corner[loop[farthest]] = HULL_MERGE_KEEP;
+    merge->stack[stackCount++] = begin;
+    merge->stack[stackCount++] = farthest;
+    merge->stack[stackCount++] = farthest;
+    merge->stack[stackCount++] = end;
+  }
+}
+
+// A face with only one or two vertices where three faces meet could be simplified away by its neighbours,
+// a thin sliver between two long edges. It keeps every vertex, before any chain is decided.
+static void fProtectFace(HullMerge *merge, int loopCount)
+{
+  int anchorCount = 0;
+  for (int i = 0; i < loopCount; i++)
+  {
+    int v = merge->canonical[merge->loop[i]];
+    if (merge->touchCount[v] >= 3 && (i == 0 || merge->canonical[merge->loop[i - 1]] != v)) anchorCount++;
+  }
+  if (anchorCount == 0 || anchorCount >= 3) return;
+  for (int i = 0; i < loopCount; i++) merge->corner[merge->canonical[merge->loop[i]]] = HULL_MERGE_KEEP;
+}
+
+// Turns the region's boundary into the face's corners. Coincident vertices become one, vertices where three
+// or more faces meet are corners. Between two of them the boundary is shared with one other face and is
+// simplified once, the face that comes later takes the same corners there and the polyhedron stays closed.
+static int fFaceCorners(HullMerge *merge, int loopCount, float tolerance)
+{
+  int *loop = merge->loop;
+  int unique = 0;
+  for (int i = 0; i < loopCount; i++)
+  {
+    int v = merge->canonical[loop[i]];
+    if (unique == 0 || loop[unique - 1] != v) loop[unique++] = v;
+  }
+  while (unique > 1 && loop[unique - 1] == loop[0]) unique--;
+
+  int firstAnchor = -1;
+  for (int i = 0; i < unique; i++)
+  {
+    if (merge->touchCount[loop[i]] < 3) continue;
+    merge->corner[loop[i]] = HULL_MERGE_KEEP;
+    if (firstAnchor < 0) firstAnchor = i;
+  }
+  if (firstAnchor < 0)
+  {
+    // Only two faces, the sides of a flat hull: the lowest index and the vertex farthest from it
+    firstAnchor = 0;
+    for (int i = 1; i < unique; i++)
+    {
+      if (loop[i] < loop[firstAnchor]) firstAnchor = i;
+    }
+    int farthest = firstAnchor;
+    double farthestDistance = -1.0;
+    for (int i = 0; i < unique; i++)
+    {
+      HullVec3d offset = HullVec3dSubtract(fVertex(merge, loop[i]), fVertex(merge, loop[firstAnchor]));
+      double distance = HullVec3dDotProduct(offset, offset);
+      if (distance > farthestDistance || (distance == farthestDistance && loop[i] < loop[farthest]))
+      {
+        farthest = i;
+        farthestDistance = distance;
+      }
+    }
+    merge->corner[loop[firstAnchor]] = HULL_MERGE_KEEP;
+    merge->corner[loop[farthest]] = HULL_MERGE_KEEP;
+  }
+
+  // Chains between consecutive kept vertices, undecided ones have not been seen by the other face yet
+  int from = firstAnchor;
+  do
+  {
+    int to = (from + 1) % unique;
+    bool undecided = false;
+    while (merge->corner[loop[to]] != HULL_MERGE_KEEP)
+    {
+      undecided |= merge->corner[loop[to]] == HULL_MERGE_UNDECIDED;
+      to = (to + 1) % unique;
+    }
+    if (undecided) fSimplifyChain(merge, loop, unique, from, to, tolerance);
+    from = to;
+  } while (from != firstAnchor);
+
+  int *corners = merge->corners;
+  int cornerCount = 0;
+  for (int i = 0; i < unique; i++)
+  {
+    if (merge->corner[loop[i]] == HULL_MERGE_KEEP) corners[cornerCount++] = loop[i];
+  }
+  if (cornerCount >= 3) return cornerCount;
+  // Nothing left to decide by, keep every vertex
+  memcpy(corners, loop, sizeof(int) * (size_t)unique);
+  return unique;
+}
+
+// The plane is the seed triangle's. A triangle of the hull has every input point on or below its plane, and
+// merging kept every corner of the face within tolerance of it.
+static void fEmitFace(HullMerge *merge, HullPolyhedron *polyhedron, const int *corners, int cornerCount, int seed)
+{
+  int face = polyhedron->faceCount;
+  int indexCount = polyhedron->faceStart[face];
+  polyhedron->faceStart = DArrayReserve(polyhedron->faceStart, &merge->faceCapacity, face + 2, sizeof(int));
+  polyhedron->planes = DArrayReserve(polyhedron->planes, &merge->planeCapacity, face + 1, sizeof(HullPlane));
+  polyhedron->indices = DArrayReserve(polyhedron->indices, &merge->indexCapacity, indexCount + cornerCount, sizeof(int));
+  memcpy(polyhedron->indices + indexCount, corners, sizeof(int) * (size_t)cornerCount);
+
+  // Offset from the rounded normal, so that the seed's corner is on the stored plane
+  HullVec3d normal = merge->normals[seed];
+  HullVec3 stored = { (float)normal.x, (float)normal.y, (float)normal.z };
+  double offset = HullVec3dDotProduct(HullVec3ToDouble(stored), fVertex(merge, merge->shape->triangles[seed].indices[0]));
+  polyhedron->planes[face] = (HullPlane){ stored, (float)offset };
+  polyhedron->faceStart[face + 1] = indexCount + cornerCount;
+  polyhedron->faceCount++;
+}
+
+// Whether a corner of the face bends inwards, seen along the seed's normal. Those corners are marked in inward
+// unless it is NULL.
+static bool fBentFace(const HullMerge *merge, const int *corners, int cornerCount, int seed, bool *inward)
+{
+  bool bent = false;
+  for (int i = 0; i < cornerCount; i++)
+  {
+    int p = corners[(i + cornerCount - 1) % cornerCount], r = corners[(i + 1) % cornerCount];
+    if (!fInwardCorner(merge, merge->normals[seed], p, corners[i], r)) continue;
+    if (inward == NULL) return true;
+    inward[corners[i]] = true;
+    bent = true;
+  }
+  return bent;
+}
+
+// Turn of a -> b -> c, positive to the left
+static double fTurn(HullMergePoint a, HullMergePoint b, HullMergePoint c)
+{
+  return (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+}
+
+// Ear clipping of the corners projected along normal, counter-clockwise, into triangles of corner positions.
+// Returns the triangle count, 0 when no ear is left before the end: the corners are not a simple polygon.
+static int fClipEars(const HullMergePoint *points, int count, int *previous, int *next, int *triangles)
+{
+  for (int i = 0; i < count; i++)
+  {
+    previous[i] = (i + count - 1) % count;
+    next[i] = (i + 1) % count;
+  }
+  int triangleCount = 0, remaining = count, i = 0;
+  for (int tried = 0; remaining > 3 && tried < remaining;)
+  {
+    int p = previous[i], n = next[i];
+    bool ear = fTurn(points[p], points[i], points[n]) > 0.0;
+    // No other corner inside the ear or on its sides
+    for (int j = next[n]; ear && j != p; j = next[j])
+    {
+      ear = fTurn(points[p], points[i], points[j]) < 0.0 || fTurn(points[i], points[n], points[j]) < 0.0 || fTurn(points[n], points[p], points[j]) < 0.0;
+    }
+    if (!ear)
+    {
+      i = n;
+      tried++;
+      continue;
+    }
+    int *triangle = triangles + 3 * triangleCount++;
+    triangle[0] = p;
+    triangle[1] = i;
+    triangle[2] = n;
+    next[p] = n;
+    previous[n] = p;
+    remaining--;
+    tried = 0;
+    i = p;
+  }
+  if (remaining > 3 || fTurn(points[previous[i]], points[i], points[next[i]]) <= 0.0) return 0;
+  int *triangle = triangles + 3 * triangleCount++;
+  triangle[0] = previous[i];
+  triangle[1] = i;
+  triangle[2] = next[i];
+  return triangleCount;
+}
+
+// Emits a face that bends inwards as convex pieces in its plane: ear clipping, then Hertel-Mehlhorn removes every
+// diagonal that leaves both of its ends convex, at most four times the fewest convex pieces. The diagonals are
+// shared by the pieces on either side, so the polyhedron stays closed. false when the corners are not a simple
+// polygon seen along the seed's normal, nothing is emitted then.
+static bool fEmitConvexPieces(HullMerge *merge, HullPolyhedron *polyhedron, const int *corners, int cornerCount, int seed)
+{
+  HullVec3d normal = merge->normals[seed];
+  HullVec3d axis = fabs(normal.x) < 0.5 ? (HullVec3d){ 1.0, 0.0, 0.0 } : (HullVec3d){ 0.0, 1.0, 0.0 };
+  HullVec3d u = HullVec3dNormalize(HullVec3dCrossProduct(normal, axis));
+  HullVec3d w = HullVec3dCrossProduct(normal, u);
+  int halfCount = 3 * (cornerCount - 2);
+  HullMergePoint *points = HullMemAlloc(sizeof(HullMergePoint) * (size_t)cornerCount);
+  int *previous = HullMemAlloc(sizeof(int) * (size_t)cornerCount);
+  int *next = HullMemAlloc(sizeof(int) * (size_t)cornerCount);
+  int *from = HullMemAlloc(sizeof(int) * (size_t)halfCount);
+  int *halfNext = HullMemAlloc(sizeof(int) * (size_t)halfCount);
+  int *halfPrevious = HullMemAlloc(sizeof(int) * (size_t)halfCount);
+  unsigned char *state = HullMemAlloc((size_t)halfCount); // 0 in a piece, 1 removed, 2 emitted
+  HullMergeEdge *edges = HullMemAlloc(sizeof(HullMergeEdge) * (size_t)halfCount);
+  for (int i = 0; i < cornerCount; i++)
+  {
+    HullVec3d p = fVertex(merge, corners[i]);
+    points[i] = (HullMergePoint){ HullVec3dDotProduct(p, u), HullVec3dDotProduct(p, w) };
+  }
+
+  int triangleCount = fClipEars(points, cornerCount, previous, next, from);
+  for (int h = 0; h < 3 * triangleCount; h++)
+  {
+    int t = h / 3, to = from[3 * t + (h + 1) % 3];
+    halfNext[h] = 3 * t + (h + 1) % 3;
+    halfPrevious[h] = 3 * t + (h + 2) % 3;
+    edges[h] = (HullMergeEdge){ (long long)(from[h] < to ? from[h] : to) * cornerCount + (from[h] < to ? to : from[h]), h };
+  }
+  qsort(edges, 3 * triangleCount, sizeof(HullMergeEdge), fCompareEdges);
+  for (int e = 0; e + 1 < 3 * triangleCount; e++)
+  {
+    if (edges[e].key != edges[e + 1].key) continue;
+    // A diagonal a -> b, the other side runs b -> a
+    int h = edges[e].half, twin = edges[e + 1].half;
+    int beforeA = halfPrevious[h], afterA = halfNext[twin];
+    int beforeB = halfPrevious[twin], afterB = halfNext[h];
+    // The end of a half edge is where the next one starts
+    if (fTurn(points[from[beforeA]], points[from[h]], points[from[halfNext[afterA]]]) < 0.0) continue;
+    if (fTurn(points[from[beforeB]], points[from[twin]], points[from[halfNext[afterB]]]) < 0.0) continue;
+    halfNext[beforeA] = afterA;
+    halfPrevious[afterA] = beforeA;
+    halfNext[beforeB] = afterB;
+    halfPrevious[afterB] = beforeB;
+    state[h] = state[twin] = 1;
+    e++;
+  }
+
+  for (int h = 0; h < 3 * triangleCount; h++)
+  {
+    if (state[h] != 0) continue;
+    int pieceCount = 0;
+    for (int k = h; state[k] == 0; k = halfNext[k])
+    {
+      state[k] = 2;
+      next[pieceCount++] = corners[from[k]];
+    }
+    fEmitFace(merge, polyhedron, next, pieceCount, seed);
+  }
+  HullMemFree(edges);
+  HullMemFree(state);
+  HullMemFree(halfPrevious);
+  HullMemFree(halfNext);
+  HullMemFree(from);
+  HullMemFree(next);
+  HullMemFree(previous);
+  HullMemFree(points);
+  return triangleCount > 0;
+}
+
+// Keeps only the vertices some face uses and renumbers the corners in order of first use
+static void fCompactVertices(const ConvexShape *shape, HullPolyhedron *polyhedron)
+{
+  // remap holds the new index + 1, 0 while unused
+  int *remap = HullMemAlloc(sizeof(int) * (size_t)(shape->vertexCount > 0 ? shape->vertexCount : 1));
+  int indexCount = polyhedron->faceStart[polyhedron->faceCount];
+  int vertexCount = 0;
+  for (int i = 0; i < indexCount; i++)
+  {
+    int index = polyhedron->indices[i];
+    if (remap[index] == 0) remap[index] = ++vertexCount;
+  }
+  polyhedron->vertexCount = vertexCount;
+  polyhedron->vertices = HullMemAlloc(sizeof(HullVec3) * (size_t)(vertexCount > 0 ? vertexCount : 1));
+  for (int v = 0; v < shape->vertexCount; v++)
+  {
+    if (remap[v] > 0) polyhedron->vertices[remap[v] - 1] = shape->vertices[v];
+  }
+  for (int i = 0; i < indexCount; i++) polyhedron->indices[i] = remap[polyhedron->indices[i]] - 1;
+  HullMemFree(remap);
+}
+
+// Counting sort of the triangles by region into sorted, first gets regionCount + 1 offsets
+static void fSortByRegion(const int *region, int triangleCount, int regionCount, int *first, int *sorted)
+{
+  memset(first, 0, sizeof(int) * (size_t)(regionCount + 1));
+  for (int t = 0; t < triangleCount; t++)
+  {
+    if (region[t] >= 0) first[region[t] + 1]++;
+  }
+  for (int r = 0; r < regionCount; r++) first[r + 1] += first[r];
+  for (int t = 0; t < triangleCount; t++)
+  {
+    if (region[t] >= 0) sorted[first[region[t]]++] = t;
+  }
+  // Each offset moved on to the next region's, shift them back
+  for (int r = regionCount; r > 0; r--) first[r] = first[r - 1];
+  first[0] = 0;
+}
+
+// Leaves the facets of faces that could not be cut alone where they have an inward corner on their boundary,
+// or every facet of such a face when none has
+static void fLeaveAlone(HullMerge *merge, int facetCount)
+{
+  for (int pass = 0; pass < 2; pass++)
+  {
+    for (int f = 0; f < facetCount; f++)
+    {
+      int face = merge->facetFace[f];
+      if (merge->bent[face] == 0 || (pass == 1 && merge->bent[face] == 2)) continue;
+      bool alone = pass == 1;
+      for (int k = merge->facetFirst[f]; k < merge->facetFirst[f + 1] && !alone; k++) alone = merge->inward[merge->facetLoop[k]];
+      if (!alone) continue;
+      merge->facetAlone[f] = true;
+      if (pass == 0) merge->bent[face] = 2;
+    }
+  }
+}
+
+// Grows the faces from the facets, largest seed first, and gives every triangle its face. Returns the face count.
+static int fMergeFacets(HullMerge *merge, const HullMergeSeed *seeds, int seedCount, int facetCount, float tolerance)
+{
+  for (int f = 0; f < facetCount; f++) merge->facetFace[f] = -1;
+  int faceCount = 0;
+  for (int s = 0; s < seedCount; s++)
+  {
+    int facet = merge->facetOf[seeds[s].triangle];
+    if (facet < 0 || merge->facetFace[facet] >= 0) continue;
+    fGrowFace(merge, facet, faceCount++, tolerance);
+  }
+  for (int t = 0; t < merge->shape->triangleCount; t++)
+  {
+    merge->region[t] = merge->facetOf[t] >= 0 ? merge->facetFace[merge->facetOf[t]] : -1;
+  }
+  return faceCount;
+}
+
+// Emits the faces of merge->region, cutting the ones that bend inwards into convex pieces. Returns whether a face
+// could not be cut, those are marked in merge->bent and their inward corners in merge->inward.
+static bool fEmitFaces(HullMerge *merge, HullPolyhedron *polyhedron, int *faceFirst, int faceCount, bool merging, float tolerance)
+{
+  // The corners depend on how many faces meet at each vertex. Triangles sorted by face into members.
+  size_t vertexCount = (size_t)merge->shape->vertexCount;
+  memset(merge->touchCount, 0, sizeof(int) * vertexCount);
+  memset(merge->corner, HULL_MERGE_UNDECIDED, vertexCount);
+  memset(merge->inward, 0, sizeof(bool) * vertexCount);
+  fSortByRegion(merge->region, merge->shape->triangleCount, faceCount, faceFirst, merge->members);
+  fCountFaces(merge);
+
+  // Exact simplification keeps a vertex off the line of every chain of a face with area, nothing to protect
+  for (int f = 0; merging && f < faceCount; f++)
+  {
+    int count = faceFirst[f + 1] - faceFirst[f];
+    int loopCount = fBoundaryLoop(merge, merge->members + faceFirst[f], count, f);
+    if (loopCount >= 3) fProtectFace(merge, loopCount);
+  }
+  bool bent = false;
+  for (int f = 0; f < faceCount; f++)
+  {
+    int count = faceFirst[f + 1] - faceFirst[f];
+    int loopCount = fBoundaryLoop(merge, merge->members + faceFirst[f], count, f);
+    merge->bent[f] = 0;
+    if (loopCount < 3) continue;
+    int seed = merge->faceSeed[f];
+    int cornerCount = fFaceCorners(merge, loopCount, tolerance);
+    // A facet left alone is convex already
+    bool alone = !merging || merge->facetAlone[merge->facetOf[seed]];
+    if (alone || !fBentFace(merge, merge->corners, cornerCount, seed, NULL))
+    {
+      fEmitFace(merge, polyhedron, merge->corners, cornerCount, seed);
+    }
+    else if (!fEmitConvexPieces(merge, polyhedron, merge->corners, cornerCount, seed))
+    {
+      fBentFace(merge, merge->corners, cornerCount, seed, merge->inward);
+      merge->bent[f] = 1;
+      bent = true;
+    }
+  }
+  return bent;
+}
+
+HullPolyhedron *CreateHullPolyhedron(const ConvexShape *convexShape, float tolerance)
+{
+  if (convexShape == NULL)
+  {
+    return NULL;
+  }
+
+  HullTraceBegin("CreateHullPolyhedron");
+  tolerance = tolerance > 0.0f ? tolerance : 0.0f;
+  int triangleCount = convexShape->triangleCount;
+  size_t triangleSlots = (size_t)(triangleCount > 0 ? triangleCount : 1);
+  size_t vertexSlots = (size_t)(convexShape->vertexCount > 0 ? convexShape->vertexCount : 1);
+  HullMerge merge = { 0 };
+  merge.shape = convexShape;
+  merge.neighbours = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+  merge.normals = HullMemAlloc(sizeof(HullVec3d) * triangleSlots);
+  merge.flat = HullMemAlloc(sizeof(bool) * triangleSlots);
+  merge.region = HullMemAlloc(sizeof(int) * triangleSlots);
+  merge.members = HullMemAlloc(sizeof(int) * triangleSlots);
+  merge.outgoing = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.canonical = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.touchCount = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.firstFace = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.secondFace = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.across = HullMemAlloc(sizeof(int) * vertexSlots);
+  merge.loop = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+  merge.loopAcross = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+  merge.corners = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+  merge.corner = HullMemAlloc(vertexSlots);
+  merge.stack = HullMemAlloc(sizeof(int) * 6 * triangleSlots);
+  merge.faceSeed = HullMemAlloc(sizeof(int) * triangleSlots);
+  merge.bent = HullMemAlloc(triangleSlots);
+  merge.inward = HullMemAlloc(sizeof(bool) * vertexSlots);
+  HullMergeSeed *seeds = HullMemAlloc(sizeof(HullMergeSeed) * triangleSlots);
+  fFindNeighbours(&merge);
+  fFindCanonical(&merge);
+  for (int v = 0; v < convexShape->vertexCount; v++) merge.outgoing[v] = -1;
+
+  int seedCount = 0;
+  for (int t = 0; t < triangleCount; t++)
+  {
+    const int *indices = convexShape->triangles[t].indices;
+    HullVec3d a = fVertex(&merge, indices[0]);
+    HullVec3d cross = HullVec3dCrossProduct(HullVec3dSubtract(fVertex(&merge, indices[1]), a), HullVec3dSubtract(fVertex(&merge, indices[2]), a));
+    merge.region[t] = -1;
+    merge.flat[t] = HullCollinear(convexShape->vertices[indices[0]], convexShape->vertices[indices[1]], convexShape->vertices[indices[2]]);
+    if (merge.flat[t]) continue;
+    merge.normals[t] = HullVec3dNormalize(cross);
+    seeds[seedCount++] = (HullMergeSeed){ sqrt(HullVec3dDotProduct(cross, cross)), t };
+  }
+  qsort(seeds, seedCount, sizeof(HullMergeSeed), fCompareSeeds);
+
+  // Exactly coplanar triangles first, such a facet of a convex hull is a convex polygon.
+  // Zero area triangles no facet reaches are left out.
+  bool merging = tolerance > 0.0f;
+  if (merging)
+  {
+    merge.facetSeed = HullMemAlloc(sizeof(int) * triangleSlots);
+    merge.facetFirst = HullMemAlloc(sizeof(int) * (triangleSlots + 1));
+    merge.facetLoop = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+    merge.facetAcross = HullMemAlloc(sizeof(int) * 3 * triangleSlots);
+    merge.visited = HullMemAlloc(sizeof(int) * vertexSlots);
+  }
+  int faceCount = 0;
+  for (int s = 0; s < seedCount; s++)
+  {
+    int seed = seeds[s].triangle;
+    if (merge.region[seed] >= 0) continue;
+
+    int facet = faceCount++;
+    int count = fGrowFacet(&merge, seed, facet);
+    int loopCount = fBoundaryLoop(&merge, merge.members, count, facet);
+    if (loopCount < 3)
+    {
+      // Leave the seed on its own, a triangle is always a valid face
+      fReleaseRegion(&merge, count);
+      merge.region[seed] = facet;
+      loopCount = fBoundaryLoop(&merge, &seed, 1, facet);
+    }
+    merge.faceSeed[facet] = seed;
+    if (merging) fStoreFacet(&merge, facet, seed, loopCount);
+  }
+
+  // Then whole facets within tolerance of a common plane, each face stays convex.
+  // Growing triangle by triangle would let a face take the slivers along the edge of its neighbour.
+  int facetCount = faceCount;
+  if (merging)
+  {
+    for (int k = 0; k < merge.facetFirst[facetCount]; k++)
+    {
+      int t = merge.facetAcross[k];
+      merge.facetAcross[k] = t >= 0 ? merge.region[t] : -1;
+    }
+    merge.facetFace = HullMemAlloc(sizeof(int) * (size_t)(facetCount > 0 ? facetCount : 1));
+    merge.facetAlone = HullMemAlloc(sizeof(bool) * (size_t)(facetCount > 0 ? facetCount : 1));
+    merge.facetOf = HullMemAlloc(sizeof(int) * triangleSlots);
+    memcpy(merge.facetOf, merge.region, sizeof(int) * (size_t)triangleCount);
+  }
+
+  HullPolyhedron *polyhedron = HullMemAlloc(sizeof(HullPolyhedron));
+  polyhedron->faceStart = DArrayReserve(NULL, &merge.faceCapacity, 1, sizeof(int));
+  polyhedron->faceStart[0] = 0;
+  int *faceFirst = HullMemAlloc(sizeof(int) * (triangleSlots + 1));
+  // A face whose corners are not a simple polygon along its normal cannot be cut. The facets at its inward corners
+  // are left alone and the faces grown again, every round leaves at least one more alone: a facet is a convex
+  // polygon, so this ends.
+  bool bent;
+  do
+  {
+    if (merging) faceCount = fMergeFacets(&merge, seeds, seedCount, facetCount, tolerance);
+    polyhedron->faceCount = 0;
+    bent = fEmitFaces(&merge, polyhedron, faceFirst, faceCount, merging, tolerance);
+    if (bent) fLeaveAlone(&merge, facetCount);
+  } while (bent);
+  fCompactVertices(convexShape, polyhedron);
+
+  HullMemFree(faceFirst);
+  HullMemFree(seeds);
+  HullMemFree(merge.inward);
+  HullMemFree(merge.bent);
+  HullMemFree(merge.faceSeed);
+  HullMemFree(merge.visited);
+  HullMemFree(merge.facetOf);
+  HullMemFree(merge.facetAlone);
+  HullMemFree(merge.facetFace);
+  HullMemFree(merge.facetAcross);
+  HullMemFree(merge.facetLoop);
+  HullMemFree(merge.facetFirst);
+  HullMemFree(merge.facetSeed);
+  HullMemFree(merge.stack);
+  HullMemFree(merge.corner);
+  HullMemFree(merge.corners);
+  HullMemFree(merge.loopAcross);
+  HullMemFree(merge.loop);
+  HullMemFree(merge.across);
+  HullMemFree(merge.secondFace);
+  HullMemFree(merge.firstFace);
+  HullMemFree(merge.touchCount);
+  HullMemFree(merge.canonical);
+  HullMemFree(merge.outgoing);
+  HullMemFree(merge.members);
+  HullMemFree(merge.region);
+  HullMemFree(merge.flat);
+  HullMemFree(merge.normals);
+  HullMemFree(merge.neighbours);
+  HullTraceEnd();
+  return polyhedron;
+}
+
+void ClearHullPolyhedron(HullPolyhedron *polyhedron)
+{
+  if (polyhedron == NULL)
+  {
+    return;
+  }
+  polyhedron->faceCount = 0;
+  HullMemFree(polyhedron->faceStart);
+  polyhedron->faceStart = NULL;
+  HullMemFree(polyhedron->indices);
+  polyhedron->indices = NULL;
+  HullMemFree(polyhedron->planes);
+  polyhedron->planes = NULL;
+  polyhedron->vertexCount = 0;
+  HullMemFree(polyhedron->vertices);
+  polyhedron->vertices = NULL;
+}
+
+ConvexShape *HullPolyhedronTriangulate(const HullPolyhedron *polyhedron)
+{
+  if (polyhedron == NULL)
+  {
+    return NULL;
+  }
+
+  ConvexShape *shape = (ConvexShape *)HullMemAlloc(sizeof(ConvexShape));
+  shape->vertexCount = polyhedron->vertexCount;
+  shape->vertices = HullMemAlloc(sizeof(HullVec3) * (size_t)(polyhedron->vertexCount > 0 ? polyhedron->vertexCount : 1));
+  memcpy(shape->vertices, polyhedron->vertices, sizeof(HullVec3) * (size_t)polyhedron->vertexCount);
+
+  // k corners give k - 2 triangles, 2 fewer per face than corners
+  int triangleCount = polyhedron->faceStart[polyhedron->faceCount] - 2 * polyhedron->faceCount;
+  shape->triangles = HullMemAlloc(sizeof(ConvexShapeTriangle) * (size_t)(triangleCount > 0 ? triangleCount : 1));
+  for (int f = 0; f < polyhedron->faceCount; f++)
+  {
+    const int *corners = polyhedron->indices + polyhedron->faceStart[f];
+    int cornerCount = polyhedron->faceStart[f + 1] - polyhedron->faceStart[f];
+    for (int i = 1; i + 1 < cornerCount; i++)
+    {
+      shape->triangles[shape->triangleCount++] = (ConvexShapeTriangle){ { corners[0], corners[i], corners[i + 1] } };
+    }
+  }
+  return shape;
+}
@@ -0,0 +1,35 @@
+#ifndef HULL_POLYHEDRON_H_
+#define HULL_POLYHEDRON_H_
+#include "hull_core.h"
+#include "convex_hull.h"
+
+// Plane of a face: normal . p <= offset for every point of the hull, the unit normal points out of it
+typedef struct HullPlane {
+  HullVec3 normal;
+  float offset;
+} HullPlane;
+
+// Hull with its coplanar triangles merged into convex polygons
+typedef struct HullPolyhedron {
+  int vertexCount;
+  HullVec3 *vertices; // Only the corners of the faces
+  int faceCount;
+  int *faceStart;     // faceCount + 1 offsets, face f has the corners indices[faceStart[f]] .. indices[faceStart[f + 1] - 1]
+  int *indices;       // Corners of every face, counter-clockwise seen from outside
+  HullPlane *planes;  // One per face
+} HullPolyhedron;
+
+// Merges neighbouring triangles of the shape into convex polygons. tolerance 0 merges exactly coplanar
+// triangles only, decided by the exact predicates. Otherwise exactly coplanar regions are merged while every
+// corner lies within tolerance of the plane of the face's largest triangle, which becomes the face's plane, and
+// corners within tolerance of a straight edge are dropped. A merged face that bends inwards is cut into convex
+// pieces along diagonals, so neighbouring faces can share a plane. Every face is convex seen along its plane,
+// every corner lies within tolerance of that plane and every input point lies on or below every face plane, up
+// to float rounding. Faces keep sharing their edges, zero area triangles disappear into their neighbours.
+// NULL for a NULL shape.
+HullPolyhedron *CreateHullPolyhedron(const ConvexShape *convexShape, float tolerance);
+void ClearHullPolyhedron(HullPolyhedron *polyhedron);
+// Triangulated view for rendering: a fan per face, k corners give k - 2 triangles with the face's winding
+ConvexShape *HullPolyhedronTriangulate(const HullPolyhedron *polyhedron);
+
+#endif
@@ -0,0 +1,428 @@
+#include "hull_predicates.h"
+#include <string.h>
+
+// Bound of Shewchuk's orient3d filter for the evaluation order in HullOrient3d
+#define ORIENT_ERRBOUND ((7.0 + 56.0 * HULL_ORIENT_EPSILON) * HULL_ORIENT_EPSILON)
+// Shewchuk's ccwerrboundA, the 2D counterpart
+#define ORIENT2D_ERRBOUND ((3.0 + 16.0 * HULL_ORIENT_EPSILON) * HULL_ORIENT_EPSILON)
+// 2^27 + 1, splits a double into two 26 bit halves
+#define ORIENT_SPLITTER 134217729.0
+
+float HullOrientExtent(const HullVec3 v[], int n)
+{
+  float extent = 0.0f;
+  for (int i = 0; i < n; i++)
+  {
+    extent = fmaxf(extent, fmaxf(fabsf(v[i].x), fmaxf(fabsf(v[i].y), fabsf(v[i].z))));
+  }
+  return extent;
+}
+
+double HullOrientExtentDouble(const HullVec3d v[], int n)
+{
+  double extent = 0.0;
+  for (int i = 0; i < n; i++)
+  {
+    extent = fmax(extent, fmax(fabs(v[i].x), fmax(fabs(v[i].y), fabs(v[i].z))));
+  }
+  return extent;
+}
+
+double HullOrient3d(HullVec3 a, HullVec3 b, HullVec3 c, HullVec3 d)
+{
+  // Floats widen to double exactly, so the double predicate is exact for them too
+  return HullOrient3dDouble(HullVec3ToDouble(a), HullVec3ToDouble(b), HullVec3ToDouble(c), HullVec3ToDouble(d));
+}
+
+double HullOrient3dExact(HullVec3 a, HullVec3 b, HullVec3 c, HullVec3 d)
+{
+  return HullOrient3dExactDouble(HullVec3ToDouble(a), HullVec3ToDouble(b), HullVec3ToDouble(c), HullVec3ToDouble(d));
+}
+
+double HullOrient3dDouble(HullVec3d a, HullVec3d b, HullVec3d c, HullVec3d d)
+{
+  // The bound covers the rounding of the differences as well
+  double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+  double vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+  double wx = d.x - a.x, wy = d.y - a.y, wz = d.z - a.z;
+
+  double uyvz = uy * vz, uzvy = uz * vy;
+  double uzvx = uz * vx, uxvz = ux * vz;
+  double uxvy = ux * vy, uyvx = uy * vx;
+
+  double det = wx * (uyvz - uzvy) + wy * (uzvx - uxvz) + wz * (uxvy - uyvx);
+  double permanent = fabs(wx) * (fabs(uyvz) + fabs(uzvy))
+    + fabs(wy) * (fabs(uzvx) + fabs(uxvz))
+    + fabs(wz) * (fabs(uxvy) + fabs(uyvx));
+  if (fabs(det) > ORIENT_ERRBOUND * permanent) return det;
+  return HullOrient3dExactDouble(a, b, c, d);
+}
+
+// Expansion arithmetic. An expansion is a sum of non-overlapping doubles, smallest magnitude first.
+
+// x + y == a + b exactly, requires |a| >= |b|
+static inline void fFastTwoSum(double a, double b, double *x, double *y)
+{
+  *x = a + b;
+  *y = b - (*x - a);
+}
+
+static inline void fTwoSum(double a, double b, double *x, double *y)
+{
+  *x = a + b;
+  double bVirtual = *x - a;
+  double aVirtual = *x - bVirtual;
+  *y = (a - aVirtual) + (b - bVirtual);
+}
+
+static inline void fTwoDiff(double a, double b, double *x, double *y)
+{
+  *x = a - b;
+  double bVirtual = a - *x;
+  double aVirtual = *x + bVirtual;
+  *y = (a - aVirtual) + (bVirtual - b);
+}
+
+static inline void fSplit(double a, double *high, double *low)
+{
+  double c = ORIENT_SPLITTER * a;
+  *high = c - (c - a);
+  *low = a - *high;
+}
+
+static inline void fTwoProduct(double a, double b, double *x, double *y)
+{
+  *x = a * b;
+  double aHigh, aLow, bHigh, bLow;
+  fSplit(a, &aHigh, &aLow);
+  fSplit(b, &bHigh, &bLow);
+  double err1 = *x - aHigh * bHigh;
+  double err2 = err1 - aLow * bHigh;
+  double err3 = err2 - aHigh * bLow;
+  *y = aLow * bLow - err3;
+}
+
+// (a1 + a0) - (b1 + b0) as a four component expansion
+static void fTwoTwoDiff(double a1, double a0, double b1, double b0, double x[4])
+{
+  double i, j, k;
+  fTwoDiff(a0, b0, &i, &x[0]);
+  fTwoSum(a1, i, &j, &k);
+  fTwoDiff(k, b1, &i, &x[1]);
+  fTwoSum(j, i, &x[3], &x[2]);
+}
+
+// a.x * b.y - b.x * a.y
+static void fCross2(HullVec3d a, HullVec3d b, double x[4])
+{
+  double p1, p0, q1, q0;
+  fTwoProduct(a.x, b.y, &p1, &p0);
+  fTwoProduct(b.x, a.y, &q1, &q0);
+  fTwoTwoDiff(p1, p0, q1, q0, x);
+}
+
+// h = e + f with zero components dropped, h needs room for eLength + fLength
+static int fExpansionSum(int eLength, const double *e, int fLength, const double *f, double *h)
+{
+  int eIndex = 0, fIndex = 0, hIndex = 0;
+  double eNow = e[0], fNow = f[0];
+  double q, qNew, hh;
+
+  if ((fNow > eNow) == (fNow > -eNow))
+  {
+    q = eNow;
+    eNow = ++eIndex < eLength ? e[eIndex] : 0.0;
+  }
+  else
+  {
+    q = fNow;
+    fNow = ++fIndex < fLength ? f[fIndex] : 0.0;
+  }
+  if (eIndex < eLength && fIndex < fLength)
+  {
+    if ((fNow > eNow) == (fNow > -eNow))
+    {
+      fFastTwoSum(eNow, q, &qNew, &hh);
+      eNow = ++eIndex < eLength ? e[eIndex] : 0.0;
+    }
+    else
+    {
+      fFastTwoSum(fNow, q, &qNew, &hh);
+      fNow = ++fIndex < fLength ? f[fIndex] : 0.0;
+    }
+    q = qNew;
+    if (hh != 0.0) h[hIndex++] = hh;
+    while (eIndex < eLength && fIndex < fLength)
+    {
+      if ((fNow > eNow) == (fNow > -eNow))
+      {
+        fTwoSum(q, eNow, &qNew, &hh);
+        eNow = ++eIndex < eLength ? e[eIndex] : 0.0;
+      }
+      else
+      {
+        fTwoSum(q, fNow, &qNew, &hh);
+        fNow = ++fIndex < fLength ? f[fIndex] : 0.0;
+      }
+      q = qNew;
+      if (hh != 0.0) h[hIndex++] = hh;
+    }
+  }
+  while (eIndex < eLength)
+  {
+    fTwoSum(q, eNow, &qNew, &hh);
+    eNow = ++eIndex < eLength ? e[eIndex] : 0.0;
+    q = qNew;
+    if (hh != 0.0) h[hIndex++] = hh;
+  }
+  while (fIndex < fLength)
+  {
+    fTwoSum(q, fNow, &qNew, &hh);
+    fNow = ++fIndex < fLength ? f[fIndex] : 0.0;
+    q = qNew;
+    if (hh != 0.0) h[hIndex++] = hh;
+  }
+  if (q != 0.0 || hIndex == 0) h[hIndex++] = q;
+  return hIndex;
+}
+
+// h = e * b with zero components dropped, h needs room for 2 * eLength
+static int fExpansionScale(int eLength, const double *e, double b, double *h)
+{
+  int hIndex = 0;
+  double q, hh, product1, product0, sum;
+  fTwoProduct(e[0], b, &q, &hh);
+  if (hh != 0.0) h[hIndex++] = hh;
+  for (int i = 1; i < eLength; i++)
+  {
+    fTwoProduct(e[i], b, &product1, &product0);
+    fTwoSum(q, product0, &sum, &hh);
+    if (hh != 0.0) h[hIndex++] = hh;
+    fFastTwoSum(product1, sum, &q, &hh);
+    if (hh != 0.0) h[hIndex++] = hh;
+  }
+  if (q != 0.0 || hIndex == 0) h[hIndex++] = q;
+  return hIndex;
+}
+
+// Port of Shewchuk's orient3dexact, which computes det(a - d, b - d, c - d) as a sum of 2x2 minors.
+// That is the negation of our convention, so the result is flipped at the end.
+double HullOrient3dExactDouble(HullVec3d a, HullVec3d b, HullVec3d c, HullVec3d d)
+{
+  double ab[4], bc[4], cd[4], da[4], ac[4], bd[4];
+  fCross2(a, b, ab);
+  fCross2(b, c, bc);
+  fCross2(c, d, cd);
+  fCross2(d, a, da);
+  fCross2(a, c, ac);
+  fCross2(b, d, bd);
+
+  double temp8[8];
+  double abc[12], bcd[12], cda[12], dab[12];
+  int tempLength = fExpansionSum(4, cd, 4, da, temp8);
+  int cdaLength = fExpansionSum(tempLength, temp8, 4, ac, cda);
+  tempLength = fExpansionSum(4, da, 4, ab, temp8);
+  int dabLength = fExpansionSum(tempLength, temp8, 4, bd, dab);
+  for (int i = 0; i < 4; i++)
+  {
+    bd[i] = -bd[i];
+    ac[i] = -ac[i];
+  }
+  tempLength = fExpansionSum(4, ab, 4, bc, temp8);
+  int abcLength = fExpansionSum(tempLength, temp8, 4, ac, abc);
+  tempLength = fExpansionSum(4, bc, 4, cd, temp8);
+  int bcdLength = fExpansionSum(tempLength, temp8, 4, bd, bcd);
+
+  double adet[24], bdet[24], cdet[24], ddet[24];
+  int aLength = fExpansionScale(bcdLength, bcd, a.z, adet);
+  int bLength = fExpansionScale(cdaLength, cda, -b.z, bdet);
+  int cLength = fExpansionScale(dabLength, dab, c.z, cdet);
+  int dLength = fExpansionScale(abcLength, abc, -d.z, ddet);
+
+  double abdet[48], cddet[48], deter[96];
+  int abLength = fExpansionSum(aLength, adet, bLength, bdet, abdet);
+  int cdLength = fExpansionSum(cLength, cdet, dLength, ddet, cddet);
+  int deterLength = fExpansionSum(abLength, abdet, cdLength, cddet, deter);
+
+  // The largest component carries the sign
+  return -deter[deterLength - 1];
+}
+
+// Simulation of simplicity, Edelsbrunner and Muecke: coordinate j of the point with the k-th smallest index
+// moves by eps^(2^(3k + 2 - j)). The perturbed determinant of the rows (p, 1) is a polynomial in eps whose
+// terms, ordered by significance, follow the bit masks over (point, coordinate) in increasing order. Every
+// coefficient is a minor of the unperturbed matrix, the first nonzero one decides the sign.
+
+// Exact sign of a.u * b.v - b.u * a.v + b.u * c.v - c.u * b.v + c.u * a.v - a.u * c.v, the 2D orientation
+static int fOrient2dSign(double au, double av, double bu, double bv, double cu, double cv)
+{
+  double ab[4], bc[4], ca[4], temp8[8], sum[12];
+  fCross2((HullVec3d){ au, av, 0.0 }, (HullVec3d){ bu, bv, 0.0 }, ab);
+  fCross2((HullVec3d){ bu, bv, 0.0 }, (HullVec3d){ cu, cv, 0.0 }, bc);
+  fCross2((HullVec3d){ cu, cv, 0.0 }, (HullVec3d){ au, av, 0.0 }, ca);
+  int tempLength = fExpansionSum(4, ab, 4, bc, temp8);
+  int sumLength = fExpansionSum(tempLength, temp8, 4, ca, sum);
+  double top = sum[sumLength - 1];
+  return (top > 0.0) - (top < 0.0);
+}
+
+// Sign of the perturbed det of the rows (p[k], 1), rows in increasing index order. Never zero.
+static int fPerturbedSign(const double p[4][3])
+{
+  for (int mask = 1; mask < 1 << 12; mask++)
+  {
+    // Column of each row taken by the perturbation, -1 for none
+    int rowColumn[4] = { -1, -1, -1, -1 };
+    bool columnUsed[4] = { false, false, false, false };
+    bool valid = true;
+    int taken = 0;
+    for (int bit = 0; bit < 12 && valid; bit++)
+    {
+      if (!(mask & (1 << bit))) continue;
+      int row = bit / 3;
+      int column = 2 - bit % 3;
+      valid = rowColumn[row] < 0 && !columnUsed[column];
+      rowColumn[row] = column;
+      columnUsed[column] = true;
+      taken++;
+    }
+    if (!valid) continue;
+
+    // Remaining rows and columns, the column of ones is always among them
+    int rows[3], columns[3], restCount = 0, columnCount = 0;
+    for (int k = 0; k < 4; k++)
+    {
+      if (rowColumn[k] < 0) rows[restCount++] = k;
+      if (k == 3 || !columnUsed[k]) columns[columnCount++] = k;
+    }
+
+    int minorSign;
+    if (taken == 1)
+    {
+      minorSign = fOrient2dSign(p[rows[0]][columns[0]], p[rows[0]][columns[1]],
+        p[rows[1]][columns[0]], p[rows[1]][columns[1]],
+        p[rows[2]][columns[0]], p[rows[2]][columns[1]]);
+    }
+    else if (taken == 2)
+    {
+      double a = p[rows[0]][columns[0]], b = p[rows[1]][columns[0]];
+      minorSign = (a > b) - (a < b);
+    }
+    else
+    {
+      minorSign = 1;
+    }
+    if (minorSign == 0) continue;
+
+    // Sign of the permutation taking row k to its column, remaining rows to remaining columns in order
+    int permutation[4];
+    for (int k = 0, next = 0; k < 4; k++)
+    {
+      permutation[k] = rowColumn[k] >= 0 ? rowColumn[k] : columns[next++];
+    }
+    int inversions = 0;
+    for (int i = 0; i < 4; i++)
+    {
+      for (int k = i + 1; k < 4; k++) inversions += permutation[i] > permutation[k];
+    }
+    return inversions % 2 ? -minorSign : minorSign;
+  }
+  return 1; // Not reached, a mask with three rows always has the minor 1
+}
+
+// Orders the four points by index and applies the perturbation, p holds their coordinates in argument order
+static int fOrient3dPerturbed(const double p[4][3], const int index[4])
+{
+  int order[4] = { 0, 1, 2, 3 };
+  int parity = 0;
+  for (int i = 1; i < 4; i++)
+  {
+    for (int k = i; k > 0 && index[order[k - 1]] > index[order[k]]; k--)
+    {
+      int swap = order[k];
+      order[k] = order[k - 1];
+      order[k - 1] = swap;
+      parity ^= 1;
+    }
+  }
+  double sorted[4][3];
+  for (int k = 0; k < 4; k++)
+  {
+    memcpy(sorted[k], p[order[k]], sizeof(sorted[k]));
+  }
+  // det(b - a, c - a, d - a) is minus the det of the rows (p, 1)
+  int sign = -fPerturbedSign(sorted);
+  return parity ? -sign : sign;
+}
+
+int HullOrient3dSoS(const HullVec3 v[], int a, int b, int c, int d)
+{
+  double det = HullOrient3d(v[a], v[b], v[c], v[d]);
+  if (det != 0.0) return det > 0.0 ? 1 : -1;
+  const int index[4] = { a, b, c, d };
+  double p[4][3];
+  for (int k = 0; k < 4; k++)
+  {
+    HullVec3 point = v[index[k]];
+    p[k][0] = point.x;
+    p[k][1] = point.y;
+    p[k][2] = point.z;
+  }
+  return fOrient3dPerturbed(p, index);
+}
+
+int HullOrient3dSoSDouble(const HullVec3d v[], int a, int b, int c, int d)
+{
+  double det = HullOrient3dDouble(v[a], v[b], v[c], v[d]);
+  if (det != 0.0) return det > 0.0 ? 1 : -1;
+  const int index[4] = { a, b, c, d };
+  double p[4][3];
+  for (int k = 0; k < 4; k++)
+  {
+    HullVec3d point = v[index[k]];
+    p[k][0] = point.x;
+    p[k][1] = point.y;
+    p[k][2] = point.z;
+  }
+  return fOrient3dPerturbed(p, index);
+}
+
+int HullOrient3dGridSoS(const HullVec3i v[], int a, int b, int c, int d)
+{
+  int det = HullOrient3dGrid(v[a], v[b], v[c], v[d]);
+  if (det != 0) return det;
+  // Grid coordinates are exact in double, so are the minors through expansion arithmetic
+  const int index[4] = { a, b, c, d };
+  double p[4][3];
+  for (int k = 0; k < 4; k++)
+  {
+    HullVec3i point = v[index[k]];
+    p[k][0] = point.x;
+    p[k][1] = point.y;
+    p[k][2] = point.z;
+  }
+  return fOrient3dPerturbed(p, index);
+}
+
+// fOrient2dSign behind the usual filter
+static int fOrient2dSignFiltered(double au, double av, double bu, double bv, double cu, double cv)
+{
+  double left = (au - cu) * (bv - cv);
+  double right = (av - cv) * (bu - cu);
+  double det = left - right;
+  if (fabs(det) > ORIENT2D_ERRBOUND * (fabs(left) + fabs(right))) return (det > 0.0) - (det < 0.0);
+  return fOrient2dSign(au, av, bu, bv, cu, cv);
+}
+
+int HullOrient2d(double au, double av, double bu, double bv, double cu, double cv)
+{
+  return fOrient2dSignFiltered(au, av, bu, bv, cu, cv);
+}
+
+bool HullCollinear(HullVec3 a, HullVec3 b, HullVec3 c)
+{
+  // Collinear in 3D exactly when collinear in all three axis projections
+  return fOrient2dSignFiltered(a.x, a.y, b.x, b.y, c.x, c.y) == 0
+    && fOrient2dSignFiltered(a.y, a.z, b.y, b.z, c.y, c.z) == 0
+    && fOrient2dSignFiltered(a.z, a.x, b.z, b.x, c.z, c.x) == 0;
+}
@@ -0,0 +1,129 @@
+#ifndef HULL_PREDICATES_H_
+#define HULL_PREDICATES_H_
+#include "hull_core.h"
+
+// Robust orientation test after Shewchuk, "Adaptive Precision Floating-Point Arithmetic and
+// Fast Robust Geometric Predicates". A double precision filter with a certified error bound
+// decides almost every call, exact expansion arithmetic only runs when the sign is uncertain.
+// NOTE: Needs IEEE double arithmetic, do not build the library with -ffast-math or x87 excess precision.
+
+// Half an ulp of 1.0
+#define HULL_ORIENT_EPSILON 1.1102230246251565e-16
+
+// Plane through a, b and c for many tests against points of a known extent.
+// The error bound is computed once for the whole extent, so a test costs the same as a plain plane equation.
+typedef struct HullOrientPlane {
+  double normal[3]; // (b - a) x (c - a), rounded
+  double offset;    // normal . a, rounded
+  double bound;     // Largest error of normal . p - offset for any point within the extent
+} HullOrientPlane;
+
+// Sign of det(b - a, c - a, d - a): positive when d is on the side (b - a) x (c - a) points to,
+// zero only when the four points are exactly coplanar. Always through expansion arithmetic.
+double HullOrient3dExact(HullVec3 a, HullVec3 b, HullVec3 c, HullVec3 d);
+// Same sign as HullOrient3dExact, usually decided by a filter with the error bound of these four points
+double HullOrient3d(HullVec3 a, HullVec3 b, HullVec3 c, HullVec3 d);
+// The same pair for double points, exact unless a product overflows or underflows
+double HullOrient3dExactDouble(HullVec3d a, HullVec3d b, HullVec3d c, HullVec3d d);
+double HullOrient3dDouble(HullVec3d a, HullVec3d b, HullVec3d c, HullVec3d d);
+// Sign of HullOrient3d(v[a], v[b], v[c], v[d]) with simulation of simplicity as the tie break: the points
+// are symbolically perturbed by their index, so four coplanar points still get a consistent sign. Never zero
+// for four distinct indices. Only the rare exactly coplanar case costs more than HullOrient3d.
+int HullOrient3dSoS(const HullVec3 v[], int a, int b, int c, int d);
+// Sign of (b - a) x (c - a) for points in a plane as 1, 0 or -1, positive when a, b, c turn counter-clockwise.
+// Exact for any double coordinates whose products neither overflow nor underflow.
+int HullOrient2d(double au, double av, double bu, double bv, double cu, double cv);
+// True when a, b and c lie exactly on one line, coincident points included
+bool HullCollinear(HullVec3 a, HullVec3 b, HullVec3 c);
+// Largest absolute coordinate, the extent for HullOrientPlaneInit
+float HullOrientExtent(const HullVec3 v[], int n);
+
+// Double coordinates the double predicates and filters are exact for: zero or a magnitude within
+// [2^-HULL_DOUBLE_MAX_EXPONENT, 2^HULL_DOUBLE_MAX_EXPONENT]. No product of their differences then
+// overflows, none underflows below the smallest normal double, and rounded to float they stay finite.
+#define HULL_DOUBLE_MAX_EXPONENT 126
+// Largest absolute coordinate, the extent for HullOrientPlaneInitDouble
+double HullOrientExtentDouble(const HullVec3d v[], int n);
+// HullOrient3dSoS for double points, the same perturbation. Exact within HULL_DOUBLE_MAX_EXPONENT.
+int HullOrient3dSoSDouble(const HullVec3d v[], int a, int b, int c, int d);
+
+// The plane filter is inline, the hull engines call it in their innermost loops. One instantiation per
+// inexact scalar from hull_plane_template.h, each with its own error bound.
+
+// HullOrientPlaneInit and HullOrientPlaneFilter: float points. With P the sum of the rounded permanents
+// |uyvz| + |uzvy| ..., the rounded normal is off by at most 4 eps P per component and |normal| <= P, so each of
+// the two dot products is off by at most 3 eps extent P. The error of normal . p - offset against
+// det(b - a, c - a, p - a) stays below 14 eps extent P, 16 leaves room for the rounding of the bound itself.
+// Products of floats can neither underflow nor overflow a double.
+#define HULL_P_V HullVec3
+#define HULL_P_T float
+#define HULL_P_BOUND 16.0
+#define HULL_P_FN(op) HullOrientPlane##op
+#include "hull_plane_template.h"
+
+// HullOrientPlaneInitDouble and HullOrientPlaneFilterDouble: double points. The differences round as well,
+// which adds 2 eps P per normal component and so 4 eps extent P: below 18 eps extent P, 24 leaves room.
+// Within HULL_DOUBLE_MAX_EXPONENT nothing overflows or underflows.
+#define HULL_P_V HullVec3d
+#define HULL_P_T double
+#define HULL_P_BOUND 24.0
+#define HULL_P_FN(op) HullOrientPlane##op##Double
+#include "hull_plane_template.h"
+
+// Orientation on the grid is plain integer arithmetic: with |coordinate| <= HULL_GRID_MAX the normal
+// fits 64 bits and the determinant fits HullGridDet. Up to HULL_GRID_NARROW_MAX the determinant fits
+// 64 bits as well, which is all there is without 128 bit integers.
+#define HULL_GRID_NARROW_MAX 524288 // 2^19
+#if defined(__SIZEOF_INT128__)
+  typedef __int128 HullGridDet;
+  #define HULL_GRID_MAX 1073741823  // 2^30 - 1
+#else
+  typedef int64_t HullGridDet;
+  #define HULL_GRID_MAX HULL_GRID_NARROW_MAX
+#endif
+
+// Plane through a, b and c on the grid, exact
+typedef struct HullGridPlane {
+  int64_t normal[3]; // (b - a) x (c - a)
+  HullVec3i anchor;  // a
+} HullGridPlane;
+
+static inline void HullGridPlaneInit(HullGridPlane *plane, HullVec3i a, HullVec3i b, HullVec3i c)
+{
+  int64_t ux = (int64_t)b.x - a.x, uy = (int64_t)b.y - a.y, uz = (int64_t)b.z - a.z;
+  int64_t vx = (int64_t)c.x - a.x, vy = (int64_t)c.y - a.y, vz = (int64_t)c.z - a.z;
+  plane->normal[0] = uy * vz - uz * vy;
+  plane->normal[1] = uz * vx - ux * vz;
+  plane->normal[2] = ux * vy - uy * vx;
+  plane->anchor = a;
+}
+
+// det(b - a, c - a, p - a), same convention as HullOrient3d but exact
+static inline HullGridDet HullGridPlaneDet(const HullGridPlane *plane, HullVec3i p)
+{
+  return (HullGridDet)plane->normal[0] * ((int64_t)p.x - plane->anchor.x)
+    + (HullGridDet)plane->normal[1] * ((int64_t)p.y - plane->anchor.y)
+    + (HullGridDet)plane->normal[2] * ((int64_t)p.z - plane->anchor.z);
+}
+
+// HullGridPlaneDet for planes and points within HULL_GRID_NARROW_MAX
+static inline int64_t HullGridPlaneDetNarrow(const HullGridPlane *plane, HullVec3i p)
+{
+  return plane->normal[0] * ((int64_t)p.x - plane->anchor.x)
+    + plane->normal[1] * ((int64_t)p.y - plane->anchor.y)
+    + plane->normal[2] * ((int64_t)p.z - plane->anchor.z);
+}
+
+// Sign of det(b - a, c - a, d - a) as 1, 0 or -1
+static inline int HullOrient3dGrid(HullVec3i a, HullVec3i b, HullVec3i c, HullVec3i d)
+{
+  HullGridPlane plane;
+  HullGridPlaneInit(&plane, a, b, c);
+  HullGridDet det = HullGridPlaneDet(&plane, d);
+  return (det > 0) - (det < 0);
+}
+
+// HullOrient3dSoS for grid points, the same perturbation
+int HullOrient3dGridSoS(const HullVec3i v[], int a, int b, int c, int d);
+
+#endif
@@ -0,0 +1,73 @@
+// Vector type and operations for one scalar type, hull_core.h includes this once per scalar.
+// No include guard on purpose, every instantiation is generated at compile time from these parameters:
+//   HULL_T          scalar type
+//   HULL_T_WIDE     type of dot products, wide enough for the sum of three products
+//   HULL_T_EXACT    1 for integer scalars: Equals compares exactly, there is no cross product or Normalize
+//   HULL_T_EPSILON  relative tolerance of Equals, inexact scalars only
+//   HULL_T_ABS, HULL_T_MAX, HULL_T_SQRT  math functions of HULL_T, inexact scalars only
+//   HULL_V          vector type name
+//   HULL_V_FN(op)   name of an operation on HULL_V
+// Every parameter is undefined again at the end.
+
+typedef struct HULL_V {
+  HULL_T x;
+  HULL_T y;
+  HULL_T z;
+} HULL_V;
+
+static inline HULL_V HULL_V_FN(Add)(HULL_V a, HULL_V b)
+{
+  return (HULL_V){ a.x + b.x, a.y + b.y, a.z + b.z };
+}
+
+static inline HULL_V HULL_V_FN(Subtract)(HULL_V a, HULL_V b)
+{
+  return (HULL_V){ a.x - b.x, a.y - b.y, a.z - b.z };
+}
+
+static inline HULL_V HULL_V_FN(Scale)(HULL_V v, HULL_T scale)
+{
+  return (HULL_V){ v.x * scale, v.y * scale, v.z * scale };
+}
+
+static inline HULL_T_WIDE HULL_V_FN(DotProduct)(HULL_V a, HULL_V b)
+{
+  return (HULL_T_WIDE)a.x * b.x + (HULL_T_WIDE)a.y * b.y + (HULL_T_WIDE)a.z * b.z;
+}
+
+#if HULL_T_EXACT
+static inline bool HULL_V_FN(Equals)(HULL_V a, HULL_V b)
+{
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+#else
+static inline HULL_V HULL_V_FN(CrossProduct)(HULL_V a, HULL_V b)
+{
+  return (HULL_V){ a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+}
+
+static inline HULL_V HULL_V_FN(Normalize)(HULL_V v)
+{
+  HULL_T length = HULL_T_SQRT(v.x * v.x + v.y * v.y + v.z * v.z);
+  if (length == 0) return v;
+  return HULL_V_FN(Scale)(v, 1 / length);
+}
+
+// Relative comparison, for floats the same tolerance as raymath's Vector3Equals
+static inline bool HULL_V_FN(Equals)(HULL_V a, HULL_V b)
+{
+  return HULL_T_ABS(a.x - b.x) <= HULL_T_EPSILON * HULL_T_MAX(1, HULL_T_MAX(HULL_T_ABS(a.x), HULL_T_ABS(b.x)))
+      && HULL_T_ABS(a.y - b.y) <= HULL_T_EPSILON * HULL_T_MAX(1, HULL_T_MAX(HULL_T_ABS(a.y), HULL_T_ABS(b.y)))
+      && HULL_T_ABS(a.z - b.z) <= HULL_T_EPSILON * HULL_T_MAX(1, HULL_T_MAX(HULL_T_ABS(a.z), HULL_T_ABS(b.z)));
+}
+#endif
+
+#undef HULL_T
+#undef HULL_T_WIDE
+#undef HULL_T_EXACT
+#undef HULL_T_EPSILON
+#undef HULL_T_ABS
+#undef HULL_T_MAX
+#undef HULL_T_SQRT
+#undef HULL_V
+#undef HULL_V_FN
@@ -0,0 +1,26 @@
+#include "hull_time.h"
+
+#if defined(_WIN32)
+// NOTE: Declared by hand, windows.h clashes with raylib.h in programs that include both
+typedef union { struct { unsigned long low; long high; } parts; long long quadPart; } HullLargeInteger;
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(HullLargeInteger *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(HullLargeInteger *frequency);
+
+double HullTimeNow(void)
+{
+  HullLargeInteger counter;
+  HullLargeInteger frequency;
+  QueryPerformanceCounter(&counter);
+  QueryPerformanceFrequency(&frequency);
+  return (double)counter.quadPart / (double)frequency.quadPart;
+}
+#else
+#include <time.h>
+
+double HullTimeNow(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+#endif
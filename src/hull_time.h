@@ -0,0 +1,7 @@
+#ifndef HULL_TIME_H_
+#define HULL_TIME_H_
+
+// Monotonic clock in seconds, usable without a window (raylib's GetTime needs one)
+double HullTimeNow(void);
+
+#endif
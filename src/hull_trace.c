@@ -0,0 +1,222 @@
+#include "hull_trace.h"
+#include "hull_time.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+
+typedef struct HullTraceEvent {
+  const char *name;
+  double start;
+  double end;
+} HullTraceEvent;
+
+typedef struct HullTraceBuffer {
+  struct HullTraceBuffer *next; // Registry, buffers are never unlinked
+  atomic_bool inUse;            // Owned by a running thread
+  int tid;
+  const char *threadName;
+  int generation;               // Capture the events belong to
+  HullTraceEvent *events;
+  int capacity;
+  atomic_llong writeCount;
+  // Open scopes, starts are negative when the scope began outside a capture
+  int depth;
+  const char *openNames[HULL_TRACE_MAX_DEPTH];
+  double openStarts[HULL_TRACE_MAX_DEPTH];
+} HullTraceBuffer;
+
+static atomic_bool recording;
+static atomic_int generation;
+static atomic_int eventCapacity = HULL_TRACE_DEFAULT_EVENTS;
+static double captureStart;
+
+static pthread_mutex_t registryLock = PTHREAD_MUTEX_INITIALIZER;
+static HullTraceBuffer *buffers;
+static int nextTid = 1;
+static pthread_once_t keyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t threadKey;
+static _Thread_local HullTraceBuffer *threadBuffer;
+
+static void fReleaseBuffer(void *arg)
+{
+  atomic_store(&((HullTraceBuffer *)arg)->inUse, false);
+}
+
+static void fCreateKey(void)
+{
+  pthread_key_create(&threadKey, fReleaseBuffer);
+}
+
+static HullTraceBuffer *fThreadBuffer(void)
+{
+  if (threadBuffer)
+  {
+    return threadBuffer;
+  }
+  pthread_once(&keyOnce, fCreateKey);
+  pthread_mutex_lock(&registryLock);
+  // Take over the buffer of a finished thread, parallel loops start new threads every time
+  HullTraceBuffer *buffer = buffers;
+  while (buffer && atomic_load(&buffer->inUse))
+  {
+    buffer = buffer->next;
+  }
+  if (buffer == NULL)
+  {
+    buffer = HullMemAlloc(sizeof(HullTraceBuffer));
+    buffer->tid = nextTid++;
+    buffer->next = buffers;
+    buffers = buffer;
+  }
+  atomic_store(&buffer->inUse, true);
+  buffer->depth = 0;
+  pthread_mutex_unlock(&registryLock);
+
+  pthread_setspecific(threadKey, buffer);
+  threadBuffer = buffer;
+  return buffer;
+}
+
+static void fRecord(HullTraceBuffer *buffer, const char *name, double start, double end)
+{
+  int current = atomic_load_explicit(&generation, memory_order_relaxed);
+  if (buffer->generation != current || buffer->events == NULL)
+  {
+    // First event of this capture on this thread
+    int capacity = atomic_load_explicit(&eventCapacity, memory_order_relaxed);
+    if (buffer->capacity != capacity)
+    {
+      HullMemFree(buffer->events);
+      buffer->events = HullMemAlloc(sizeof(HullTraceEvent) * capacity);
+      buffer->capacity = capacity;
+    }
+    atomic_store_explicit(&buffer->writeCount, 0, memory_order_relaxed);
+    buffer->generation = current;
+  }
+  long long index = atomic_load_explicit(&buffer->writeCount, memory_order_relaxed);
+  buffer->events[index % buffer->capacity] = (HullTraceEvent){ name, start, end };
+  atomic_store_explicit(&buffer->writeCount, index + 1, memory_order_release);
+}
+
+void HullTraceStart(int eventsPerThread)
+{
+  atomic_store(&eventCapacity, eventsPerThread > 0 ? eventsPerThread : HULL_TRACE_DEFAULT_EVENTS);
+  captureStart = HullTimeNow();
+  atomic_fetch_add(&generation, 1);
+  atomic_store(&recording, true);
+}
+
+void HullTraceStop(void)
+{
+  atomic_store(&recording, false);
+}
+
+bool HullTraceIsRecording(void)
+{
+  return atomic_load_explicit(&recording, memory_order_relaxed);
+}
+
+void HullTraceBegin(const char *name)
+{
+  bool active = atomic_load_explicit(&recording, memory_order_relaxed);
+  // Threads that never recorded have nothing to balance
+  if (!active && threadBuffer == NULL)
+  {
+    return;
+  }
+  HullTraceBuffer *buffer = fThreadBuffer();
+  if (buffer->depth < HULL_TRACE_MAX_DEPTH)
+  {
+    buffer->openNames[buffer->depth] = name;
+    buffer->openStarts[buffer->depth] = active ? HullTimeNow() : -1.0;
+  }
+  buffer->depth++;
+}
+
+void HullTraceEnd(void)
+{
+  HullTraceBuffer *buffer = threadBuffer;
+  if (buffer == NULL || buffer->depth == 0)
+  {
+    return;
+  }
+  buffer->depth--;
+  if (buffer->depth < HULL_TRACE_MAX_DEPTH && buffer->openStarts[buffer->depth] >= 0.0 && HullTraceIsRecording())
+  {
+    fRecord(buffer, buffer->openNames[buffer->depth], buffer->openStarts[buffer->depth], HullTimeNow());
+  }
+}
+
+void HullTraceComplete(const char *name, double startSeconds, double endSeconds)
+{
+  if (!HullTraceIsRecording())
+  {
+    return;
+  }
+  fRecord(fThreadBuffer(), name, startSeconds, endSeconds);
+}
+
+void HullTraceSetThreadName(const char *name)
+{
+  fThreadBuffer()->threadName = name;
+}
+
+static void fWriteJsonString(FILE *file, const char *text)
+{
+  fputc('"', file);
+  for (const char *c = text; *c; c++)
+  {
+    if (*c == '"' || *c == '\\') fprintf(file, "\\%c", *c);
+    else if ((unsigned char)*c < 0x20) fprintf(file, "\\u%04x", *c);
+    else fputc(*c, file);
+  }
+  fputc('"', file);
+}
+
+// Microseconds since the capture started
+static double fTraceMicros(double seconds)
+{
+  return seconds > captureStart ? (seconds - captureStart) * 1e6 : 0.0;
+}
+
+bool HullTraceSave(const char *fileName)
+{
+  FILE *file = fopen(fileName, "w");
+  if (file == NULL)
+  {
+    HullLog(HULL_LOG_WARNING, "TRACE: [%s] Failed to open file", fileName);
+    return false;
+  }
+  int current = atomic_load(&generation);
+  fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+  fprintf(file, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"hull\"}}");
+
+  pthread_mutex_lock(&registryLock);
+  for (HullTraceBuffer *buffer = buffers; buffer; buffer = buffer->next)
+  {
+    if (buffer->threadName)
+    {
+      fprintf(file, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": ", buffer->tid);
+      fWriteJsonString(file, buffer->threadName);
+      fprintf(file, "}}");
+    }
+    if (buffer->generation != current || buffer->events == NULL)
+    {
+      continue;
+    }
+    long long count = atomic_load_explicit(&buffer->writeCount, memory_order_acquire);
+    long long first = count > buffer->capacity ? count - buffer->capacity : 0;
+    for (long long i = first; i < count; i++)
+    {
+      HullTraceEvent *event = &buffer->events[i % buffer->capacity];
+      double start = fTraceMicros(event->start);
+      fprintf(file, ",\n{\"name\": ");
+      fWriteJsonString(file, event->name);
+      fprintf(file, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}", buffer->tid, start, fTraceMicros(event->end) - start);
+    }
+  }
+  pthread_mutex_unlock(&registryLock);
+
+  fprintf(file, "\n]}\n");
+  return fclose(file) == 0;
+}
@@ -0,0 +1,29 @@
+#ifndef HULL_TRACE_H_
+#define HULL_TRACE_H_
+#include "hull_core.h"
+
+// Lightweight tracing with Chrome trace JSON export, open the file in Perfetto or chrome://tracing.
+// Every thread records into its own ring buffer, when it is full the oldest events are overwritten.
+// Event names are not copied, pass string literals or other strings that outlive the capture.
+// While no capture is running every call returns after one atomic load.
+
+#define HULL_TRACE_DEFAULT_EVENTS 65536 // Per thread
+#define HULL_TRACE_MAX_DEPTH 32         // Nesting of HullTraceBegin per thread
+
+// Starts a new capture and drops the previous one, eventsPerThread <= 0 uses HULL_TRACE_DEFAULT_EVENTS
+void HullTraceStart(int eventsPerThread);
+void HullTraceStop(void);
+bool HullTraceIsRecording(void);
+
+// Scoped events, every HullTraceBegin needs a HullTraceEnd on the same thread
+void HullTraceBegin(const char *name);
+void HullTraceEnd(void);
+// Event with known bounds, times from HullTimeNow
+void HullTraceComplete(const char *name, double startSeconds, double endSeconds);
+// Shown as the track name of the calling thread
+void HullTraceSetThreadName(const char *name);
+
+// Writes the last capture, call it after HullTraceStop or while threads are idle
+bool HullTraceSave(const char *fileName);
+
+#endif
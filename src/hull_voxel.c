@@ -0,0 +1,258 @@
+#include "hull_voxel.h"
+#include "hull_parallel.h"
+#include "hull_trace.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Cell corners are multiples of the cell size below 2^24 of them, so every corner is exact in float
+#define HULL_VOXEL_MAX_CORNER 16777216.0
+
+typedef struct HullVoxelContext {
+  const HullVec3 *v;
+  int axis;           // Columns run along the longest axis
+  double cellSize;    // Power of two
+  double base[3];     // Lowest cell, in cells from the origin
+  int cells[3];
+  atomic_int *first;  // Column -> lowest occupied cell along the axis, cells[axis] when empty
+  atomic_int *last;   // Column -> highest occupied cell, -1 when empty
+} HullVoxelContext;
+
+static void fAtomicMin(atomic_int *value, int candidate)
+{
+  int current = atomic_load_explicit(value, memory_order_relaxed);
+  while (candidate < current && !atomic_compare_exchange_weak_explicit(value, &current, candidate, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+}
+
+static void fAtomicMax(atomic_int *value, int candidate)
+{
+  int current = atomic_load_explicit(value, memory_order_relaxed);
+  while (candidate > current && !atomic_compare_exchange_weak_explicit(value, &current, candidate, memory_order_relaxed, memory_order_relaxed))
+  {
+  }
+}
+
+static bool fIsFinite(HullVec3 p)
+{
+  return isfinite(p.x) && isfinite(p.y) && isfinite(p.z);
+}
+
+static void fBinRange(void *context, int begin, int end)
+{
+  HullVoxelContext *ctx = (HullVoxelContext *)context;
+  int u = (ctx->axis + 1) % 3, w = (ctx->axis + 2) % 3;
+  for (int i = begin; i < end; i++)
+  {
+    if (!fIsFinite(ctx->v[i])) continue;
+    float coordinates[3] = { ctx->v[i].x, ctx->v[i].y, ctx->v[i].z };
+    int cell[3];
+    for (int k = 0; k < 3; k++)
+    {
+      // Division by a power of two is exact, so the point lies inside its cell's bounds
+      cell[k] = (int)(floor(coordinates[k] / ctx->cellSize) - ctx->base[k]);
+    }
+    int column = cell[u] * ctx->cells[w] + cell[w];
+    fAtomicMin(&ctx->first[column], cell[ctx->axis]);
+    fAtomicMax(&ctx->last[column], cell[ctx->axis]);
+  }
+}
+
+// Level along the axis of one end face of a column: side 0 the low one, side 1 the high one. -1 for an empty
+// column or one outside the grid.
+static int fFaceLevel(const HullVoxelContext *ctx, int ju, int jw, int side)
+{
+  int u = (ctx->axis + 1) % 3, w = (ctx->axis + 2) % 3;
+  if (ju < 0 || jw < 0 || ju >= ctx->cells[u] || jw >= ctx->cells[w]) return -1;
+  int column = ju * ctx->cells[w] + jw;
+  int last = atomic_load_explicit(&ctx->last[column], memory_order_relaxed);
+  if (last < 0) return -1;
+  return side == 0 ? atomic_load_explicit(&ctx->first[column], memory_order_relaxed) : last + 1;
+}
+
+// Keeps the first and the last key of every run of keys with the same key / stride, the runs being the
+// lattice rows of corners at one level. Keys must be sorted. Returns the count left.
+static int fKeepRowEnds(int64_t *keys, int count, int64_t stride)
+{
+  int kept = 0;
+  for (int i = 0; i < count; i++)
+  {
+    bool first = i == 0 || keys[i - 1] / stride != keys[i] / stride;
+    bool last = i == count - 1 || keys[i + 1] / stride != keys[i] / stride;
+    if (first || last) keys[kept++] = keys[i];
+  }
+  return kept;
+}
+
+static int fCompareLattice(const void *a, const void *b)
+{
+  int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+  return (x > y) - (x < y);
+}
+
+// SplitMix64 finaliser, a bijection, so sorting by it shuffles the keys the same way every time
+static uint64_t fMixKey(int64_t key)
+{
+  uint64_t x = (uint64_t)key;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static int fCompareKeys(const void *a, const void *b)
+{
+  uint64_t x = fMixKey(*(const int64_t *)a), y = fMixKey(*(const int64_t *)b);
+  return (x > y) - (x < y);
+}
+
+HullVoxelFilter *CreateHullVoxelFilter(const HullVec3 v[], int n, int resolution, int threadCount)
+{
+  if (resolution < 2 || resolution > HULL_VOXEL_MAX_RESOLUTION)
+  {
+    return NULL;
+  }
+
+  HullTraceBegin("CreateHullVoxelFilter");
+  HullVoxelFilter *filter = HullMemAlloc(sizeof(HullVoxelFilter));
+  double low[3] = { INFINITY, INFINITY, INFINITY }, high[3] = { -INFINITY, -INFINITY, -INFINITY };
+  for (int i = 0; i < n; i++)
+  {
+    if (!fIsFinite(v[i])) continue;
+    float coordinates[3] = { v[i].x, v[i].y, v[i].z };
+    for (int k = 0; k < 3; k++)
+    {
+      low[k] = fmin(low[k], coordinates[k]);
+      high[k] = fmax(high[k], coordinates[k]);
+    }
+    filter->inputCount++;
+  }
+
+  HullVoxelContext ctx = { .v = v };
+  double span = 0.0;
+  for (int k = 0; k < 3; k++)
+  {
+    if (high[k] - low[k] > span)
+    {
+      span = high[k] - low[k];
+      ctx.axis = k;
+    }
+  }
+  if (!(span > 0.0))
+  {
+    // At most one distinct point, it is its own hull
+    filter->points = HullMemAlloc(sizeof(HullVec3));
+    for (int i = 0; i < n && filter->count == 0; i++)
+    {
+      if (fIsFinite(v[i])) filter->points[filter->count++] = v[i];
+    }
+    HullTraceEnd();
+    return filter;
+  }
+
+  // Smallest power of two cell that fits the longest side into resolution cells with exact corners
+  ctx.cellSize = ldexp(1.0, ilogb(span / resolution));
+  for (;;)
+  {
+    bool fits = true;
+    for (int k = 0; k < 3; k++)
+    {
+      ctx.base[k] = floor(low[k] / ctx.cellSize);
+      double top = floor(high[k] / ctx.cellSize);
+      ctx.cells[k] = (int)fmin(top - ctx.base[k] + 1.0, (double)HULL_VOXEL_MAX_RESOLUTION + 1.0);
+      fits &= ctx.cells[k] <= resolution && fmax(fabs(ctx.base[k]), fabs(top + 1.0)) < HULL_VOXEL_MAX_CORNER;
+    }
+    if (fits) break;
+    ctx.cellSize *= 2.0;
+  }
+  filter->cellSize = (float)ctx.cellSize;
+  // A corner is within the diagonal of its cell from a point in it, rounded up
+  filter->errorBound = nextafterf((float)(ctx.cellSize * sqrt(3.0)), INFINITY);
+
+  int u = (ctx.axis + 1) % 3, w = (ctx.axis + 2) % 3;
+  int columnCount = ctx.cells[u] * ctx.cells[w];
+  ctx.first = HullMemAlloc(sizeof(atomic_int) * (size_t)columnCount);
+  ctx.last = HullMemAlloc(sizeof(atomic_int) * (size_t)columnCount);
+  for (int c = 0; c < columnCount; c++)
+  {
+    atomic_init(&ctx.first[c], ctx.cells[ctx.axis]);
+    atomic_init(&ctx.last[c], -1);
+  }
+  HullParallelFor(n, threadCount, fBinRange, &ctx);
+
+  // Corners on a lattice line are collinear, only the two ends of a line can be on the hull. Along the axis
+  // that leaves the lowest and the highest corner of the four columns around each lattice vertex (a, b):
+  // (a - 1, b - 1), (a, b - 1), (a - 1, b) and (a, b).
+  int64_t rowU = ctx.cells[u] + 1, rowW = ctx.cells[w] + 1;
+  int64_t *keys = HullMemAlloc(sizeof(int64_t) * 2 * (size_t)(rowU * rowW));
+  int keyCount = 0;
+  for (int a = 0; a < rowU; a++)
+  {
+    for (int b = 0; b < rowW; b++)
+    {
+      for (int side = 0; side < 2; side++)
+      {
+        int extreme = -1;
+        for (int k = 0; k < 4; k++)
+        {
+          int level = fFaceLevel(&ctx, a - 1 + (k & 1), b - 1 + (k >> 1), side);
+          if (level >= 0 && (extreme < 0 || (side == 0 ? level < extreme : level > extreme))) extreme = level;
+        }
+        if (extreme >= 0) keys[keyCount++] = ((int64_t)extreme * rowU + a) * rowW + b;
+      }
+    }
+  }
+  // Then the ends of the rows along w and along u at each level, which also removes the inside of flat patches
+  // of column ends. Each pass drops only corners between two it keeps, so the hull stays the same.
+  qsort(keys, (size_t)keyCount, sizeof(int64_t), fCompareLattice);
+  keyCount = fKeepRowEnds(keys, keyCount, rowW);
+  for (int i = 0; i < keyCount; i++)
+  {
+    int64_t level = keys[i] / rowW / rowU, a = keys[i] / rowW % rowU, b = keys[i] % rowW;
+    keys[i] = (level * rowW + b) * rowU + a;
+  }
+  qsort(keys, (size_t)keyCount, sizeof(int64_t), fCompareLattice);
+  keyCount = fKeepRowEnds(keys, keyCount, rowU);
+  for (int i = 0; i < keyCount; i++)
+  {
+    int64_t level = keys[i] / rowU / rowW, b = keys[i] / rowU % rowW, a = keys[i] % rowU;
+    keys[i] = (level * rowU + a) * rowW + b;
+  }
+
+  // In a random looking order: in lattice order every corner would land outside the hull built so far
+  qsort(keys, (size_t)keyCount, sizeof(int64_t), fCompareKeys);
+
+  filter->points = HullMemAlloc(sizeof(HullVec3) * (size_t)(keyCount > 0 ? keyCount : 1));
+  for (int i = 0; i < keyCount; i++)
+  {
+    int64_t lattice[3];
+    lattice[w] = keys[i] % rowW;
+    lattice[u] = keys[i] / rowW % rowU;
+    lattice[ctx.axis] = keys[i] / rowW / rowU;
+    float corner[3];
+    for (int k = 0; k < 3; k++)
+    {
+      corner[k] = (float)((ctx.base[k] + (double)lattice[k]) * ctx.cellSize);
+    }
+    filter->points[filter->count++] = (HullVec3){ corner[0], corner[1], corner[2] };
+  }
+
+  HullMemFree(keys);
+  HullMemFree(ctx.last);
+  HullMemFree(ctx.first);
+  HullTraceEnd();
+  return filter;
+}
+
+void ClearHullVoxelFilter(HullVoxelFilter *filter)
+{
+  if (filter == NULL)
+  {
+    return;
+  }
+  HullMemFree(filter->points);
+  filter->points = NULL;
+  filter->count = 0;
+  filter->inputCount = 0;
+}
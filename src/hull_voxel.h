@@ -0,0 +1,31 @@
+#ifndef HULL_VOXEL_H_
+#define HULL_VOXEL_H_
+#include "hull_core.h"
+
+#define HULL_VOXEL_MAX_RESOLUTION 2048
+
+// Few candidate points whose hull encloses the input, for level of detail and broadphase shapes.
+typedef struct HullVoxelFilter {
+  int count;
+  HullVec3 *points;  // Corners of the outermost occupied cells, not input points
+  int inputCount;    // Finite input points that were binned
+  float cellSize;
+  float errorBound;  // The hull of points contains the exact hull and lies within this distance of it
+} HullVoxelFilter;
+
+// Bins the points into a voxel grid and takes, for every column of cells along the longest axis, the outer face
+// corners of its first and last occupied cell. Only that axis is scanned: the extremes along the other two come
+// from the columns at the edge of the grid, not from columns of their own. Of the corners on one grid line along
+// the axis only the lowest and highest are kept, and of those on one grid line across it at the same level only
+// the two ends, which drops every corner inside a flat patch of column ends since the kept ones' hull holds it.
+// That leaves at most 2 * (resolution + 1)^2 candidates for any point cloud, in a shuffled order so that a build
+// does not meet them one sweep at a time. Cells are the power of two size that gives at most resolution cells
+// along the longest side, and the corners are exact multiples of cellSize: build them with
+// HullBuildBeginQuantized(..., cellSize, ...), the float path is slow on that many coplanar points. The hull of
+// points contains every input point, and every corner is within a cell diagonal of one. Binning runs on
+// threadCount threads (0 = every core).
+// Points with a NaN or infinite coordinate are ignored. NULL when resolution is outside [2, HULL_VOXEL_MAX_RESOLUTION].
+HullVoxelFilter *CreateHullVoxelFilter(const HullVec3 v[], int n, int resolution, int threadCount);
+void ClearHullVoxelFilter(HullVoxelFilter *filter);
+
+#endif
@@ -0,0 +1,335 @@
+#include "hull_weld.h"
+#include "hull_parallel.h"
+#include "hull_trace.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Cells of one parity class never neighbour each other, so a round can decide all of them at once
+#define HULL_WELD_CLASSES 8
+
+typedef struct HullWeldCell {
+  int64_t key[3];
+  int first;     // Points of the cell are at first .. first + count - 1 in cell order, by input index
+  int count;
+  int keptCount; // Kept points of the cell so far, from kept[first] on
+} HullWeldCell;
+
+typedef struct HullWeldContext {
+  double reach;           // Tolerance with some slack for the rounding of cell bounds
+  double toleranceSquared;
+  double cellSize;        // Four times the tolerance, a point reaches a neighbouring cell along an axis half the time
+  int radius;             // Neighbouring cells searched each way, 0 when only exact duplicates weld
+  // Cells are numbered in the order of their first point
+  HullWeldCell *cells;
+  int *slots;             // Open addressing table of cell numbers, -1 where empty
+  uint64_t slotMask;
+  // Bitmap over the high hash bits, set for every cell. Most neighbour lookups find no cell and the bitmap
+  // answers those from cache instead of walking the table.
+  uint64_t *occupied;
+  int occupiedShift;
+  // Points in cell order, so a round reads them in step with its cells
+  int *cellPoints;        // Cell order -> input index
+  HullVec3 *ordered;
+  int *kept;              // Cell order positions of kept points
+  int *joined;            // Cell order -> position of the kept point it joins
+  const int *roundCells;  // Cells of the class being decided
+} HullWeldContext;
+
+static uint64_t fHashCell(const int64_t key[3])
+{
+  // Polynomial over the coordinates, which keeps small neighbouring keys apart, then the SplitMix64 finaliser
+  uint64_t x = ((uint64_t)key[0] * 0x9E3779B97F4A7C15ULL + (uint64_t)key[1]) * 0x9E3779B97F4A7C15ULL + (uint64_t)key[2];
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+// Cell of a point, false when a coordinate is not finite. Without a cell size the cell is the point itself.
+// Cells are centred on multiples of the cell size, which keeps quantised input off the cell bounds.
+static bool fCellOf(HullVec3 p, double cellSize, int64_t key[3])
+{
+  float coordinates[3] = { p.x, p.y, p.z };
+  for (int k = 0; k < 3; k++)
+  {
+    if (!isfinite(coordinates[k])) return false;
+    if (cellSize > 0.0)
+    {
+      // CreateHullWeld keeps every coordinate within 2^40 cells of the origin
+      key[k] = (int64_t)floor(coordinates[k] / cellSize + 0.5);
+    }
+    else
+    {
+      // Adding zero turns -0 into +0, the same position
+      float value = coordinates[k] + 0.0f;
+      uint32_t bits;
+      memcpy(&bits, &value, sizeof(bits));
+      key[k] = bits;
+    }
+  }
+  return true;
+}
+
+// Number of the cell, or of a new one when insert is set, -1 when there is none
+static int fFindCell(HullWeldContext *ctx, const int64_t key[3], int *cellCount, bool insert)
+{
+  uint64_t hash = fHashCell(key);
+  uint64_t bit = hash >> ctx->occupiedShift;
+  if (!insert && !(ctx->occupied[bit >> 6] >> (bit & 63) & 1)) return -1;
+  for (uint64_t slot = hash & ctx->slotMask;; slot = (slot + 1) & ctx->slotMask)
+  {
+    int cell = ctx->slots[slot];
+    if (cell < 0)
+    {
+      if (!insert) return -1;
+      cell = (*cellCount)++;
+      memcpy(ctx->cells[cell].key, key, sizeof(ctx->cells[cell].key));
+      ctx->slots[slot] = cell;
+      ctx->occupied[bit >> 6] |= 1ULL << (bit & 63);
+      return cell;
+    }
+    if (memcmp(ctx->cells[cell].key, key, sizeof(ctx->cells[cell].key)) == 0) return cell;
+  }
+}
+
+static double fDistanceSquared(HullVec3 a, HullVec3 b)
+{
+  double x = (double)a.x - b.x, y = (double)a.y - b.y, z = (double)a.z - b.z;
+  return x * x + y * y + z * z;
+}
+
+// Decides the cells of one round. Neighbours belong to other classes: they are either complete or not started,
+// and only the cell itself is written.
+static void fWeldCells(void *context, int begin, int end)
+{
+  HullWeldContext *ctx = (HullWeldContext *)context;
+  for (int r = begin; r < end; r++)
+  {
+    HullWeldCell *cell = &ctx->cells[ctx->roundCells[r]];
+    // Neighbour cells are looked up once per cell and only when a point comes within tolerance of them
+    int neighbours[27];
+    for (int k = 0; k < 27; k++) neighbours[k] = -2;
+    neighbours[13] = ctx->roundCells[r];
+
+    for (int i = cell->first; i < cell->first + cell->count; i++)
+    {
+      HullVec3 p = ctx->ordered[i];
+      // Offsets per axis this point can reach
+      int low[3] = { 0, 0, 0 }, high[3] = { 0, 0, 0 };
+      if (ctx->radius > 0)
+      {
+        float coordinates[3] = { p.x, p.y, p.z };
+        for (int k = 0; k < 3; k++)
+        {
+          double offset = coordinates[k] - ((double)cell->key[k] - 0.5) * ctx->cellSize;
+          low[k] = -(offset <= ctx->reach);
+          high[k] = offset >= ctx->cellSize - ctx->reach;
+        }
+      }
+
+      int best = -1, bestIndex = 0;
+      for (int dx = low[0]; dx <= high[0]; dx++)
+      {
+        for (int dy = low[1]; dy <= high[1]; dy++)
+        {
+          for (int dz = low[2]; dz <= high[2]; dz++)
+          {
+            int slot = (dx + 1) * 9 + (dy + 1) * 3 + dz + 1;
+            if (neighbours[slot] == -2)
+            {
+              int64_t probe[3] = { cell->key[0] + dx, cell->key[1] + dy, cell->key[2] + dz };
+              neighbours[slot] = fFindCell(ctx, probe, NULL, false);
+            }
+            if (neighbours[slot] < 0) continue;
+            const HullWeldCell *other = &ctx->cells[neighbours[slot]];
+            const int *kept = ctx->kept + other->first;
+            for (int k = 0; k < other->keptCount; k++)
+            {
+              if (fDistanceSquared(p, ctx->ordered[kept[k]]) <= ctx->toleranceSquared &&
+                  (best < 0 || ctx->cellPoints[kept[k]] < bestIndex))
+              {
+                best = kept[k];
+                bestIndex = ctx->cellPoints[best];
+              }
+            }
+          }
+        }
+      }
+      if (best < 0)
+      {
+        best = i;
+        ctx->kept[cell->first + cell->keptCount++] = i;
+      }
+      ctx->joined[i] = best;
+    }
+  }
+}
+
+typedef struct HullWeldGather {
+  const HullVec3 *v;
+  const HullWeldContext *ctx;
+  int *representative; // Input index -> input index of the kept point it joins
+  const int *compact;  // Index into points of every kept input point
+  HullWeld *weld;
+} HullWeldGather;
+
+static void fRepresentRange(void *context, int begin, int end)
+{
+  HullWeldGather *gather = (HullWeldGather *)context;
+  const int *cellPoints = gather->ctx->cellPoints;
+  for (int i = begin; i < end; i++)
+  {
+    gather->representative[cellPoints[i]] = cellPoints[gather->ctx->joined[i]];
+  }
+}
+
+static void fGatherRange(void *context, int begin, int end)
+{
+  HullWeldGather *gather = (HullWeldGather *)context;
+  for (int i = begin; i < end; i++)
+  {
+    int representative = gather->representative[i];
+    gather->weld->remap[i] = gather->compact[representative];
+    if (representative == i) gather->weld->points[gather->compact[i]] = gather->v[i];
+  }
+}
+
+HullWeld *CreateHullWeld(const HullVec3 v[], int n, float tolerance, int threadCount)
+{
+  if (!(tolerance >= 0.0f) || n < 0)
+  {
+    return NULL;
+  }
+
+  // Cell keys of a tolerance tiny next to the coordinates would not fit an int64_t
+  if (tolerance > 0.0f)
+  {
+    double largest = 0.0;
+    for (int i = 0; i < n; i++)
+    {
+      float coordinates[3] = { v[i].x, v[i].y, v[i].z };
+      for (int k = 0; k < 3; k++)
+      {
+        if (isfinite(coordinates[k])) largest = fmax(largest, fabs(coordinates[k]));
+      }
+    }
+    if (tolerance < largest * HULL_WELD_MIN_RELATIVE_TOLERANCE)
+    {
+      return NULL;
+    }
+  }
+
+  HullTraceBegin("CreateHullWeld");
+  size_t slots = (size_t)(n > 0 ? n : 1);
+  uint64_t slotCount = 64;
+  int slotBits = 6;
+  while (slotCount < 2 * (uint64_t)slots)
+  {
+    slotCount *= 2;
+    slotBits++;
+  }
+  HullWeldContext ctx = { 0 };
+  ctx.reach = tolerance * 1.001;
+  ctx.toleranceSquared = (double)tolerance * tolerance;
+  ctx.cellSize = 4.0 * tolerance;
+  ctx.radius = tolerance > 0.0f ? 1 : 0;
+  ctx.cells = HullMemAlloc(sizeof(HullWeldCell) * slots);
+  ctx.slots = HullMemAlloc(sizeof(int) * slotCount);
+  ctx.slotMask = slotCount - 1;
+  // Twice as many bits as slots
+  ctx.occupied = HullMemAlloc(sizeof(uint64_t) * (slotCount / 32));
+  ctx.occupiedShift = 64 - (slotBits + 1);
+  ctx.cellPoints = HullMemAlloc(sizeof(int) * slots);
+  ctx.ordered = HullMemAlloc(sizeof(HullVec3) * slots);
+  ctx.kept = HullMemAlloc(sizeof(int) * slots);
+  ctx.joined = HullMemAlloc(sizeof(int) * slots);
+  int *representative = HullMemAlloc(sizeof(int) * slots);
+  int *cellOf = HullMemAlloc(sizeof(int) * slots);
+  memset(ctx.slots, 0xFF, sizeof(int) * slotCount);
+
+  // Cells in input order, then the points of every cell by index
+  int cellCount = 0;
+  for (int i = 0; i < n; i++)
+  {
+    int64_t key[3];
+    cellOf[i] = fCellOf(v[i], ctx.cellSize, key) ? fFindCell(&ctx, key, &cellCount, true) : -1;
+    if (cellOf[i] >= 0) ctx.cells[cellOf[i]].count++;
+    representative[i] = i;
+  }
+  int orderedCount = 0;
+  for (int c = 0; c < cellCount; c++)
+  {
+    ctx.cells[c].first = orderedCount;
+    orderedCount += ctx.cells[c].count;
+    ctx.cells[c].count = 0;
+  }
+  for (int i = 0; i < n; i++)
+  {
+    if (cellOf[i] < 0) continue;
+    HullWeldCell *cell = &ctx.cells[cellOf[i]];
+    int position = cell->first + cell->count++;
+    ctx.cellPoints[position] = i;
+    ctx.ordered[position] = v[i];
+  }
+
+  // Cells by parity class, exact duplicates have no neighbours and need only one round
+  int classFirst[HULL_WELD_CLASSES + 1] = { 0 };
+  int *classCells = HullMemAlloc(sizeof(int) * (size_t)(cellCount > 0 ? cellCount : 1));
+  for (int c = 0; c < cellCount; c++)
+  {
+    const int64_t *key = ctx.cells[c].key;
+    int parity = ctx.radius > 0 ? (int)((key[0] & 1) | (key[1] & 1) << 1 | (key[2] & 1) << 2) : 0;
+    cellOf[c] = parity;
+    classFirst[parity + 1]++;
+  }
+  for (int k = 0; k < HULL_WELD_CLASSES; k++) classFirst[k + 1] += classFirst[k];
+  int classFill[HULL_WELD_CLASSES];
+  memcpy(classFill, classFirst, sizeof(classFill));
+  for (int c = 0; c < cellCount; c++) classCells[classFill[cellOf[c]]++] = c;
+  for (int k = 0; k < HULL_WELD_CLASSES; k++)
+  {
+    ctx.roundCells = classCells + classFirst[k];
+    HullParallelFor(classFirst[k + 1] - classFirst[k], threadCount, fWeldCells, &ctx);
+  }
+
+  // Kept points stay in input order
+  HullWeld *weld = HullMemAlloc(sizeof(HullWeld));
+  weld->inputCount = n;
+  weld->remap = HullMemAlloc(sizeof(int) * slots);
+  HullWeldGather gather = { v, &ctx, representative, cellOf, weld };
+  HullParallelFor(orderedCount, threadCount, fRepresentRange, &gather);
+  int *compact = cellOf;
+  for (int i = 0; i < n; i++)
+  {
+    compact[i] = representative[i] == i ? weld->count++ : -1;
+  }
+  weld->points = HullMemAlloc(sizeof(HullVec3) * (size_t)(weld->count > 0 ? weld->count : 1));
+  HullParallelFor(n, threadCount, fGatherRange, &gather);
+
+  HullMemFree(classCells);
+  HullMemFree(cellOf);
+  HullMemFree(representative);
+  HullMemFree(ctx.joined);
+  HullMemFree(ctx.kept);
+  HullMemFree(ctx.ordered);
+  HullMemFree(ctx.cellPoints);
+  HullMemFree(ctx.occupied);
+  HullMemFree(ctx.slots);
+  HullMemFree(ctx.cells);
+  HullTraceEnd();
+  return weld;
+}
+
+void ClearHullWeld(HullWeld *weld)
+{
+  if (weld == NULL)
+  {
+    return;
+  }
+  HullMemFree(weld->points);
+  weld->points = NULL;
+  HullMemFree(weld->remap);
+  weld->remap = NULL;
+  weld->count = 0;
+  weld->inputCount = 0;
+}
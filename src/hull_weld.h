@@ -0,0 +1,28 @@
+#ifndef HULL_WELD_H_
+#define HULL_WELD_H_
+#include "hull_core.h"
+
+// Input points with their duplicates and near duplicates welded together, an optional pass before any
+// hull engine: build on points, the hull's indices map back to the input through remap.
+typedef struct HullWeld {
+  int count;        // Points left
+  HullVec3 *points; // Each one is an input point, kept in input order
+  int inputCount;
+  int *remap;       // Input index -> index into points, every input point is within tolerance of its point
+} HullWeld;
+
+// Smallest positive tolerance relative to the largest coordinate magnitude, 2^-42: cells of four tolerances
+// then stay within 2^40 of the origin. Far below float precision at that magnitude, welding below it would
+// only join points close to the origin.
+#define HULL_WELD_MIN_RELATIVE_TOLERANCE 2.2737367544323206e-13
+
+// Collapses points within tolerance of each other in O(n) on a hash grid with cells four times the tolerance.
+// Every point joins a kept point within tolerance of it, and kept points are more than tolerance apart.
+// Tolerance 0 welds exact duplicates only. The cells are decided in 8 rounds, each spread over threadCount
+// threads (0 = every core), and the result does not depend on the thread count.
+// Points with a NaN or infinite coordinate are kept as they are. NULL for a negative tolerance, and for a
+// positive one below HULL_WELD_MIN_RELATIVE_TOLERANCE times the largest finite coordinate magnitude.
+HullWeld *CreateHullWeld(const HullVec3 v[], int n, float tolerance, int threadCount);
+void ClearHullWeld(HullWeld *weld);
+
+#endif
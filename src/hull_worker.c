@@ -0,0 +1,242 @@
+#include "hull_worker.h"
+#include "hull_build.h"
+#include "hull_time.h"
+#include "hull_trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void fFreeJob(HullWorkerJob *job)
+{
+  HullMemFree(job->vertices);
+  HullMemFree(job);
+}
+
+// Pops every queued job and keeps only the newest, the others are already cancelled
+static HullWorkerJob *fTakeNewestJob(HullWorker *worker)
+{
+  HullWorkerJob *newest = NULL;
+  HullWorkerJob *job;
+  while ((job = SpscRingPop(&worker->jobs)) != NULL)
+  {
+    if (newest)
+    {
+      fFreeJob(newest);
+    }
+    newest = job;
+  }
+  return newest;
+}
+
+static bool fIsCancelled(HullWorker *worker, HullWorkerJob *job)
+{
+  return atomic_load(&worker->quit) || atomic_load(&worker->latestJobId) != job->id;
+}
+
+// The final hull as the history's only step, seeking any step past 0 shows it. Takes the snapshot.
+static void fRecordFinalHull(HullHistory *history, ConvexShape *shape)
+{
+  if (shape == NULL)
+  {
+    return;
+  }
+  HullHistoryBeginStep(history);
+  for (int i = 0; i < shape->triangleCount; i++)
+  {
+    HullHistoryAddFace(history, shape->triangles[i]);
+  }
+  if (shape->edgeCount > 0)
+  {
+    HullHistorySetSegment(history, shape->edges[0]);
+  }
+  ClearConvexShape(shape);
+  HullMemFree(shape);
+}
+
+static void fRunJob(HullWorker *worker, HullWorkerJob *job)
+{
+  atomic_store(&worker->progressDone, 0);
+  atomic_store(&worker->progressTotal, job->vertexCount);
+  atomic_store(&worker->activeJobId, job->id);
+  HullTraceBegin("hullJob");
+
+  double start = HullTimeNow();
+  HullHistory *history = CreateHullHistory(job->vertices, job->vertexCount);
+  HullBuild *build = HullBuildBegin(job->vertices, job->vertexCount, job->engine);
+  build->history = job->journal ? history : NULL;
+
+  bool cancelled = false;
+  while (!build->finished)
+  {
+    HullBuildStepFor(build, HULL_WORKER_SLICE_MICROS);
+    atomic_store(&worker->progressDone, build->nextVertex);
+    if (fIsCancelled(worker, job))
+    {
+      cancelled = true;
+      break;
+    }
+  }
+  double phaseSeconds[HULL_PHASE_COUNT];
+  memcpy(phaseSeconds, build->phaseSeconds, sizeof(phaseSeconds));
+  // Without a journal only the final hull is kept, taken before the build and recorded once it is freed
+  ConvexShape *shape = !cancelled && !job->journal ? HullBuildSnapshot(build) : NULL;
+  HullBuildEnd(build);
+  fRecordFinalHull(history, shape);
+
+  if (cancelled)
+  {
+    ClearHullHistory(history);
+    HullMemFree(history);
+  }
+  else
+  {
+    HullWorkerResult *result = HullMemAlloc(sizeof(HullWorkerResult));
+    result->jobId = job->id;
+    result->history = history;
+    result->vertexCount = job->vertexCount;
+    result->buildSeconds = HullTimeNow() - start;
+    memcpy(result->phaseSeconds, phaseSeconds, sizeof(phaseSeconds));
+    // A result still in the slot was never collected and is older than this one
+    HullWorkerFreeResult(atomic_exchange(&worker->result, result));
+  }
+  atomic_store(&worker->activeJobId, 0);
+  fFreeJob(job);
+  HullTraceEnd();
+}
+
+static void *fWorkerMain(void *arg)
+{
+  HullWorker *worker = (HullWorker *)arg;
+  HullTraceSetThreadName("hull worker");
+  while (!atomic_load(&worker->quit))
+  {
+    HullWorkerJob *job = fTakeNewestJob(worker);
+    if (job == NULL)
+    {
+      // Submitters push before taking the lock, so checking under the lock cannot miss a wake up
+      pthread_mutex_lock(&worker->sleepLock);
+      while (SpscRingIsEmpty(&worker->jobs) && !atomic_load(&worker->quit))
+      {
+        pthread_cond_wait(&worker->wake, &worker->sleepLock);
+      }
+      pthread_mutex_unlock(&worker->sleepLock);
+      continue;
+    }
+    if (fIsCancelled(worker, job))
+    {
+      fFreeJob(job);
+      continue;
+    }
+    fRunJob(worker, job);
+  }
+  return NULL;
+}
+
+HullWorker *HullWorkerStart(void)
+{
+  HullWorker *worker = HullMemAlloc(sizeof(HullWorker));
+  pthread_mutex_init(&worker->sleepLock, NULL);
+  pthread_cond_init(&worker->wake, NULL);
+  SpscRingInit(&worker->jobs, HULL_WORKER_QUEUE_SIZE);
+  atomic_init(&worker->result, NULL);
+  atomic_init(&worker->latestJobId, 0);
+  atomic_init(&worker->activeJobId, 0);
+  atomic_init(&worker->progressDone, 0);
+  atomic_init(&worker->progressTotal, 0);
+  atomic_init(&worker->quit, false);
+  worker->nextJobId = 1;
+  worker->threaded = pthread_create(&worker->thread, NULL, fWorkerMain, worker) == 0;
+  if (!worker->threaded)
+  {
+    HullLog(HULL_LOG_WARNING, "WORKER: Failed to start the thread, hulls are built inline");
+  }
+  return worker;
+}
+
+// Returns the job id, or 0 when the job queue is full: submit again later, the older jobs are cancelled already
+int HullWorkerSubmit(HullWorker *worker, HullVec3 v[], int n, HullEngine engine)
+{
+  HullWorkerJob *job = HullMemAlloc(sizeof(HullWorkerJob));
+  job->id = worker->nextJobId++;
+  job->vertexCount = n;
+  job->vertices = HullMemAlloc(sizeof(HullVec3) * (n > 0 ? n : 1));
+  memcpy(job->vertices, v, sizeof(HullVec3) * n);
+  job->engine = engine;
+  job->journal = n <= HULL_WORKER_JOURNAL_MAX_POINTS;
+
+  // Cancel older jobs before the new one becomes visible
+  atomic_store(&worker->latestJobId, job->id);
+  if (!worker->threaded)
+  {
+    int id = job->id;
+    fRunJob(worker, job);
+    return id;
+  }
+  if (!SpscRingPush(&worker->jobs, job))
+  {
+    fFreeJob(job);
+    return 0;
+  }
+
+  pthread_mutex_lock(&worker->sleepLock);
+  pthread_cond_signal(&worker->wake);
+  pthread_mutex_unlock(&worker->sleepLock);
+  return job->id;
+}
+
+// Returns the newest finished result not yet taken or NULL, free it with HullWorkerFreeResult
+HullWorkerResult *HullWorkerPoll(HullWorker *worker)
+{
+  return atomic_exchange(&worker->result, NULL);
+}
+
+void HullWorkerFreeResult(HullWorkerResult *result)
+{
+  if (result == NULL)
+  {
+    return;
+  }
+  if (result->history)
+  {
+    ClearHullHistory(result->history);
+    HullMemFree(result->history);
+  }
+  HullMemFree(result);
+}
+
+// Progress of the job being built, from 0 to 1
+float HullWorkerProgress(HullWorker *worker)
+{
+  int total = atomic_load(&worker->progressTotal);
+  if (atomic_load(&worker->activeJobId) == 0 || total <= 0)
+  {
+    return 0.0f;
+  }
+  return (float)atomic_load(&worker->progressDone) / (float)total;
+}
+
+void HullWorkerStop(HullWorker *worker)
+{
+  if (worker == NULL)
+  {
+    return;
+  }
+  pthread_mutex_lock(&worker->sleepLock);
+  atomic_store(&worker->quit, true);
+  pthread_cond_signal(&worker->wake);
+  pthread_mutex_unlock(&worker->sleepLock);
+  if (worker->threaded)
+  {
+    pthread_join(worker->thread, NULL);
+  }
+
+  HullWorkerJob *job;
+  while ((job = SpscRingPop(&worker->jobs)) != NULL)
+  {
+    fFreeJob(job);
+  }
+  HullWorkerFreeResult(atomic_exchange(&worker->result, NULL));
+  SpscRingClear(&worker->jobs);
+  pthread_mutex_destroy(&worker->sleepLock);
+  pthread_cond_destroy(&worker->wake);
+  HullMemFree(worker);
+}
@@ -0,0 +1,60 @@
+#ifndef HULL_WORKER_H_
+#define HULL_WORKER_H_
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_history.h"
+#include "hull_build.h"
+#include "spsc_ring.h"
+#include <pthread.h>
+#include <stdatomic.h>
+
+#define HULL_WORKER_QUEUE_SIZE 16
+// Build time between two checks for a newer job
+#define HULL_WORKER_SLICE_MICROS 2000
+// Largest job journaled step by step, a larger one only keeps its final hull: the journal of every face ever
+// created about doubles the memory of a large build, and nobody steps through that many insertions
+#define HULL_WORKER_JOURNAL_MAX_POINTS 100000
+
+typedef struct HullWorkerJob {
+  int id;
+  int vertexCount;
+  HullVec3 *vertices;
+  HullEngine engine;
+  bool journal; // Record every step, otherwise the history only holds the final hull as its one step
+} HullWorkerJob;
+
+typedef struct HullWorkerResult {
+  int jobId;
+  HullHistory *history; // Journal of the build or its final hull alone, ownership moves to whoever takes it
+  int vertexCount;
+  double buildSeconds;
+  double phaseSeconds[HULL_PHASE_COUNT];
+} HullWorkerResult;
+
+// Builds hulls on a background thread.
+// Jobs go in through an SPSC ring and the newest result comes out through an atomic slot, the render loop
+// never waits on the worker. Submitting a job cancels every older one, including the one being built.
+// When the thread cannot be started, jobs are built inline in HullWorkerSubmit instead.
+typedef struct HullWorker {
+  pthread_t thread;
+  pthread_mutex_t sleepLock;
+  pthread_cond_t wake;
+  SpscRing jobs;           // HullWorkerJob *, main thread -> worker
+  _Atomic(HullWorkerResult *) result; // Newest uncollected result, worker -> main thread
+  bool threaded;           // False when the thread could not be started
+  atomic_int latestJobId;
+  atomic_int activeJobId;  // 0 when idle
+  atomic_int progressDone;
+  atomic_int progressTotal;
+  atomic_bool quit;
+  int nextJobId;           // Main thread only
+} HullWorker;
+
+HullWorker *HullWorkerStart(void);
+int HullWorkerSubmit(HullWorker *worker, HullVec3 v[], int n, HullEngine engine);
+HullWorkerResult *HullWorkerPoll(HullWorker *worker);
+void HullWorkerFreeResult(HullWorkerResult *result);
+float HullWorkerProgress(HullWorker *worker);
+void HullWorkerStop(HullWorker *worker);
+
+#endif
@@ -1,22 +1,74 @@
 #include "raylib.h"
 #include "convex_hull.h"
+#include "convex_hull_draw.h"
 #include "cam_control.h"
 #include "time.h"
 #include "raygui.h"
 #include "string.h"
 #include "gui_control.h"
+#include "hull_history.h"
+#include "hull_io.h"
+#include "hull_worker.h"
+#include "point_cloud.h"
+#include "point_gen.h"
+#include "hull_trace.h"
+#include "perf_overlay.h"
 #include <stdlib.h>
 
-int main() 
+#define DEFAULT_VERTEX_COUNT 20
+#define VERTEX_EXTENT 5.0f
+// Past this many vertices the labels are unreadable anyway
+#define MAX_LABELED_VERTICES 200
+#define DEFAULT_TRACE_FILE "hull_trace.json"
+
+int main(int argc, char **argv)
 {
   // Initialization
   //--------------------------------------------------------------------------------------
+  InstallPerfOverlayAllocator();
+  // Command line: --points <count> [--distribution <name>] [--load <points.xyz|points.obj>] [--huge-pages] [--trace <file.json>]
+  // --trace records from the start and saves on exit, F9 starts and stops a capture at any time.
+  // --load shows a point file instead of generated points, a file dropped on the window replaces the points as well
+  int vertexCount = DEFAULT_VERTEX_COUNT;
+  const char *pointFile = NULL;
+  PointDistribution distribution = POINTS_UNIFORM_CUBE;
+  bool hugePages = false;
+  const char *traceFile = DEFAULT_TRACE_FILE;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--points") == 0 && i + 1 < argc)
+    {
+      vertexCount = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--distribution") == 0 && i + 1 < argc)
+    {
+      distribution = GetPointDistributionFromName(argv[++i]);
+      if (distribution == POINTS_DISTRIBUTION_COUNT) distribution = POINTS_UNIFORM_CUBE;
+    }
+    else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc)
+    {
+      pointFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--huge-pages") == 0)
+    {
+      hugePages = true;
+    }
+    else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+    {
+      traceFile = argv[++i];
+      HullTraceStart(0);
+    }
+  }
+  if (vertexCount < 4) vertexCount = 4;
+  if (vertexCount > MAX_POINT_CLOUD_COUNT) vertexCount = MAX_POINT_CLOUD_COUNT;
+
   SetRandomSeed(time(NULL) % 10000);
   
   const int screenWidth = 800;
   const int screenHeight = 450;
 	
   InitWindow(screenWidth, screenHeight, "raylib");
+  HullTraceSetThreadName("main");
 
   Camera camera = { 0 };
   camera.position = (Vector3){ 5.0f, 2.0f, 8.0f };
@@ -32,14 +84,36 @@ int main()
   };
   
   // Variables
-  const int vertexCount = 20;
-  Vector3 vertices[vertexCount];
+  PointCloud cloud = { 0 };
   int vertexRandomSeed = 8742;//rand() % 10000;
-  CreateRandomVertices(vertices, vertexCount, vertexRandomSeed);
-  ConvexShape *convexShape = NULL;
+  if (pointFile != NULL){
+    if (!LoadPointFile(pointFile, &cloud, hugePages, 0)){
+      CloseWindow();
+      return EXIT_FAILURE;
+    }
+  } else {
+    cloud = CreatePointCloud(vertexCount, hugePages);
+    if (cloud.points == NULL){
+      CloseWindow();
+      return EXIT_FAILURE;
+    }
+    GeneratePoints(cloud.points, cloud.count, distribution, vertexRandomSeed, VERTEX_EXTENT, 0);
+  }
+  // Hulls are built and journaled on a worker thread, stepping only replays the difference. Clouds above
+  // HULL_WORKER_JOURNAL_MAX_POINTS only keep the final hull, every step shows it.
+  HullWorker *hullWorker = HullWorkerStart();
+  int hullJobId = 0;
+  bool hullSubmitPending = true; // The points changed since the last accepted job
+  HullHistory *hullHistory = NULL; // History of the newest finished job
+  int hullHistoryJobId = 0;
+  ConvexShape *convexShape = NULL; // Owned by hullHistory
   int step = 0;
   GuiControlLayoutState guiControlLayoutState = InitGuiControlState();
   strcpy(guiControlLayoutState.seedEditText, TextFormat("%d", vertexRandomSeed));
+  guiControlLayoutState.pointCount = cloud.count;
+  guiControlLayoutState.distribution = distribution;
+  // Left of the settings box
+  PerfOverlayState perfOverlayState = InitPerfOverlayState((Rectangle){390, 20, 200, 310});
 
   SetTargetFPS(60);         // Set our game to run at 60 frames-per-second
   //--------------------------------------------------------------------------------------
@@ -49,41 +123,76 @@ int main()
   {
     // Update
     //----------------------------------------------------------------------------------
+    if (IsKeyPressed(KEY_F9)){
+      if (HullTraceIsRecording()){
+        HullTraceStop();
+        HullTraceSave(traceFile);
+      } else {
+        HullTraceStart(0);
+      }
+    }
+    HullTraceBegin("frame");
+    HullTraceBegin("update");
+    PerfOverlayAddFrame(&perfOverlayState, GetFrameTime());
     UpdateCam(&camera, &camSettings);
     //// Randomize the seed
     if (guiControlLayoutState.seedRandomizePressed){
       vertexRandomSeed = rand() % 10000;
-      CreateRandomVertices(vertices, vertexCount, vertexRandomSeed);
+      GeneratePoints(cloud.points, cloud.count, distribution, vertexRandomSeed, VERTEX_EXTENT, 0);
       
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
+      hullSubmitPending = true;
       step = 0;
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
       
       strcpy(guiControlLayoutState.seedEditText, TextFormat("%d", vertexRandomSeed));
     }
     //// Apply a different seed
     if (guiControlLayoutState.seedApplyPressed){
       vertexRandomSeed = rand() % 10000;
-      CreateRandomVertices(vertices, vertexCount, vertexRandomSeed);
+      GeneratePoints(cloud.points, cloud.count, distribution, vertexRandomSeed, VERTEX_EXTENT, 0);
       
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
+      hullSubmitPending = true;
       step = 0;
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
+    }
+    //// Change the number of points or their distribution, keeping the seed
+    if (guiControlLayoutState.pointCountSubmitted || guiControlLayoutState.distributionChanged){
+      if (ResizePointCloud(&cloud, guiControlLayoutState.pointCount)){
+        distribution = guiControlLayoutState.distribution;
+        GeneratePoints(cloud.points, cloud.count, distribution, vertexRandomSeed, VERTEX_EXTENT, 0);
+
+        hullSubmitPending = true;
+        step = 0;
+        convexShape = HullHistorySeek(hullHistory, step);
+        strcpy(guiControlLayoutState.stepEditText, TextFormat("%d", step));
+      } else {
+        // Out of memory, the points stay as they are
+        guiControlLayoutState.pointCount = cloud.count;
+      }
+    }
+    //// Load a point file dropped on the window, the first one when there are several
+    if (IsFileDropped()){
+      FilePathList droppedFiles = LoadDroppedFiles();
+      PointCloud loaded = { 0 };
+      if (droppedFiles.count > 0 && LoadPointFile(droppedFiles.paths[0], &loaded, hugePages, 0)){
+        ClearPointCloud(&cloud);
+        cloud = loaded;
+        guiControlLayoutState.pointCount = cloud.count;
+        hullSubmitPending = true;
+        step = 0;
+        convexShape = HullHistorySeek(hullHistory, step);
+        strcpy(guiControlLayoutState.stepEditText, TextFormat("%d", step));
+      }
+      UnloadDroppedFiles(droppedFiles);
     }
     //// Show the final result
     if (guiControlLayoutState.showResultPressed){
       step = -1; // Negative step means show the final result
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
     }
     //// Clear the result
     if (guiControlLayoutState.clearPressed){
       step = 0;
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
       convexShape = NULL;
     }
     //// Step
@@ -93,18 +202,14 @@ int main()
       if (step <= 0){
         step = 0;
       }
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
 
       strcpy(guiControlLayoutState.stepEditText, TextFormat("%d", step));
     }
     //// Next & Prev
     if (guiControlLayoutState.nextStepPressed){
       step++;
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
 
       strcpy(guiControlLayoutState.stepEditText, TextFormat("%d", step));
     }
@@ -113,45 +218,102 @@ int main()
       if (step < 0){
         step = 0;
       }
-      ClearConvexShape(convexShape);
-      MemFree(convexShape);
-      convexShape = CreateConvexShape(vertices, vertexCount, step);
+      convexShape = HullHistorySeek(hullHistory, step);
 
       strcpy(guiControlLayoutState.stepEditText, TextFormat("%d", step));
     }
+    //// Hand the points to the worker once per frame, a full queue is retried on the next one
+    if (hullSubmitPending){
+      int jobId = HullWorkerSubmit(hullWorker, cloud.points, cloud.count, HULL_ENGINE_CONFLICT);
+      if (jobId != 0){
+        hullJobId = jobId;
+        hullSubmitPending = false;
+      }
+    }
+    //// Collect finished builds, a newer result replaces the shown history
+    HullTraceBegin("collectResults");
+    HullWorkerResult *hullResult;
+    while ((hullResult = HullWorkerPoll(hullWorker)) != NULL){
+      if (hullResult->jobId > hullHistoryJobId){
+        ClearHullHistory(hullHistory);
+        HullMemFree(hullHistory);
+        hullHistory = hullResult->history;
+        hullResult->history = NULL;
+        hullHistoryJobId = hullResult->jobId;
+        convexShape = HullHistorySeek(hullHistory, step);
+        PerfOverlayAddBuild(&perfOverlayState, hullResult);
+      }
+      HullWorkerFreeResult(hullResult);
+    }
+    HullTraceEnd();
+    guiControlLayoutState.building = hullSubmitPending || hullHistoryJobId != hullJobId;
+    guiControlLayoutState.resultStale = guiControlLayoutState.building && convexShape != NULL;
+    guiControlLayoutState.buildProgress = guiControlLayoutState.building ? HullWorkerProgress(hullWorker) : 1.0f;
+    perfOverlayState.faceCount = convexShape ? convexShape->triangleCount : 0;
+    HullTraceEnd();
     //----------------------------------------------------------------------------------
     
     // Draw
     //----------------------------------------------------------------------------------
+    HullTraceBegin("draw");
     BeginDrawing();
 
       ClearBackground(RAYWHITE);
 
       BeginMode3D(camera);
-        DrawVertices(vertices, vertexCount);
+        HullTraceBegin("DrawVertices");
+        DrawVertices(cloud.points, cloud.count);
+        HullTraceEnd();
         if (convexShape){
+          HullTraceBegin("DrawConvex");
           if (guiControlLayoutState.wireframeModePressed){
             DrawConvexWires(convexShape, (Vector3){0, 0, 0}, RED, (Vector3){1, 1, 1});
           } else {
             DrawConvex(convexShape, (Vector3){0, 0, 0}, RED, (Vector3){1, 1, 1});
             DrawConvexWires(convexShape, (Vector3){0, 0, 0}, ORANGE, (Vector3){1, 1, 1});
           }
+          HullTraceEnd();
         }
         DrawGrid(20, 1.0f);
       EndMode3D();
 
-      DrawVertexIndices(vertices, vertexCount, camera);
+      if (cloud.count <= MAX_LABELED_VERTICES){
+        HullTraceBegin("DrawVertexIndices");
+        DrawVertexIndices(cloud.points, cloud.count, camera);
+        HullTraceEnd();
+      }
       DrawText(TextFormat("Seed: %d", vertexRandomSeed), 10, 40, 20, DARKGRAY);
+      DrawText(TextFormat("Points: %d", cloud.count), 10, 70, 20, DARKGRAY);
+      HullTraceBegin("GuiControlLayout");
       GuiControlLayout(&guiControlLayoutState);
+      HullTraceEnd();
+      if (guiControlLayoutState.showPerfOverlay){
+        HullTraceBegin("PerfOverlayLayout");
+        PerfOverlayLayout(&perfOverlayState);
+        HullTraceEnd();
+      }
       
       DrawFPS(10, 10);
 
+    HullTraceEnd();
+    // Buffer swap and frame pacing
+    HullTraceBegin("EndDrawing");
     EndDrawing();
+    HullTraceEnd();
+    HullTraceEnd();
     //----------------------------------------------------------------------------------
   }
 
   // De-Initialization
   //--------------------------------------------------------------------------------------
+  HullWorkerStop(hullWorker);
+  if (HullTraceIsRecording()){
+    HullTraceStop();
+    HullTraceSave(traceFile);
+  }
+  ClearHullHistory(hullHistory);
+  HullMemFree(hullHistory);
+  ClearPointCloud(&cloud);
   CloseWindow();    // Close window and OpenGL context
   //--------------------------------------------------------------------------------------
 
@@ -0,0 +1,150 @@
+#include "perf_overlay.h"
+#include "raygui.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// Size in front of every block, keeps the payload 16 byte aligned
+#define PERF_OVERLAY_HEADER 16
+#define PERF_OVERLAY_LINE 18
+#define PERF_OVERLAY_GRAPH_HEIGHT 50
+
+// The worker thread allocates as well
+static atomic_size_t memoryInUse;
+
+static void *fCountingAlloc(size_t size, void *user)
+{
+  (void)user;
+  unsigned char *block = malloc(size + PERF_OVERLAY_HEADER);
+  if (block == NULL) return NULL;
+  *(size_t *)block = size;
+  atomic_fetch_add(&memoryInUse, size);
+  return block + PERF_OVERLAY_HEADER;
+}
+
+static void *fCountingRealloc(void *ptr, size_t size, void *user)
+{
+  (void)user;
+  unsigned char *block = ptr != NULL ? (unsigned char *)ptr - PERF_OVERLAY_HEADER : NULL;
+  size_t oldSize = block != NULL ? *(size_t *)block : 0;
+  unsigned char *resized = realloc(block, size + PERF_OVERLAY_HEADER);
+  if (resized == NULL) return NULL;
+  *(size_t *)resized = size;
+  atomic_fetch_add(&memoryInUse, size);
+  atomic_fetch_sub(&memoryInUse, oldSize);
+  return resized + PERF_OVERLAY_HEADER;
+}
+
+static void fCountingFree(void *ptr, void *user)
+{
+  (void)user;
+  if (ptr == NULL) return;
+  unsigned char *block = (unsigned char *)ptr - PERF_OVERLAY_HEADER;
+  atomic_fetch_sub(&memoryInUse, *(size_t *)block);
+  free(block);
+}
+
+void InstallPerfOverlayAllocator(void)
+{
+  HullSetAllocator(&(HullAllocator){ fCountingAlloc, fCountingRealloc, fCountingFree, NULL });
+}
+
+size_t GetPerfOverlayMemoryInUse(void)
+{
+  return atomic_load(&memoryInUse);
+}
+
+PerfOverlayState InitPerfOverlayState(Rectangle bounds)
+{
+  PerfOverlayState state = {0};
+  state.bounds = bounds;
+  return state;
+}
+
+static void fGraphPush(PerfOverlayGraph *graph, float value)
+{
+  graph->values[graph->next] = value;
+  graph->next = (graph->next + 1) % PERF_OVERLAY_HISTORY;
+  if (graph->count < PERF_OVERLAY_HISTORY) graph->count++;
+}
+
+void PerfOverlayAddFrame(PerfOverlayState *state, float frameSeconds)
+{
+  fGraphPush(&state->frameGraph, frameSeconds * 1000.0f);
+}
+
+void PerfOverlayAddBuild(PerfOverlayState *state, const HullWorkerResult *result)
+{
+  state->buildPoints = result->vertexCount;
+  state->buildSeconds = result->buildSeconds;
+  for (int i = 0; i < HULL_PHASE_COUNT; i++)
+  {
+    state->phaseSeconds[i] = result->phaseSeconds[i];
+  }
+  fGraphPush(&state->buildGraph, (float)(result->buildSeconds * 1000.0));
+}
+
+// Oldest sample on the left, scaled to the largest sample shown
+static void fDrawGraph(Rectangle bounds, const PerfOverlayGraph *graph, Color color)
+{
+  DrawRectangleRec(bounds, Fade(LIGHTGRAY, 0.5f));
+  if (graph->count == 0) return;
+
+  float maxValue = 0.0f;
+  for (int i = 0; i < graph->count; i++)
+  {
+    if (graph->values[i] > maxValue) maxValue = graph->values[i];
+  }
+  if (maxValue <= 0.0f) maxValue = 1.0f;
+
+  int first = (graph->next - graph->count + PERF_OVERLAY_HISTORY) % PERF_OVERLAY_HISTORY;
+  float stepX = bounds.width / (PERF_OVERLAY_HISTORY - 1);
+  Vector2 previous = { 0 };
+  for (int i = 0; i < graph->count; i++)
+  {
+    float value = graph->values[(first + i) % PERF_OVERLAY_HISTORY];
+    Vector2 point = {
+      bounds.x + (PERF_OVERLAY_HISTORY - graph->count + i) * stepX,
+      bounds.y + bounds.height - value / maxValue * bounds.height
+    };
+    if (i > 0) DrawLineV(previous, point, color);
+    previous = point;
+  }
+  DrawText(TextFormat("max %.1f", maxValue), (int)bounds.x + 2, (int)bounds.y + 2, 10, DARKGRAY);
+}
+
+static float fGraphLast(const PerfOverlayGraph *graph)
+{
+  if (graph->count == 0) return 0.0f;
+  return graph->values[(graph->next - 1 + PERF_OVERLAY_HISTORY) % PERF_OVERLAY_HISTORY];
+}
+
+void PerfOverlayLayout(PerfOverlayState *state)
+{
+  Rectangle bounds = state->bounds;
+  GuiGroupBox(bounds, "Performance");
+  Rectangle line = { bounds.x + 10, bounds.y + 10, bounds.width - 20, PERF_OVERLAY_LINE };
+
+  GuiLabel(line, TextFormat("Build: %.2f ms, %d points", state->buildSeconds * 1000.0, state->buildPoints));
+  line.y += PERF_OVERLAY_LINE;
+  for (int i = 0; i < HULL_PHASE_COUNT; i++)
+  {
+    GuiLabel(line, TextFormat("  %s: %.2f ms", GetHullPhaseName((HullPhase)i), state->phaseSeconds[i] * 1000.0));
+    line.y += PERF_OVERLAY_LINE;
+  }
+  double pointsPerSecond = state->buildSeconds > 0.0 ? state->buildPoints / state->buildSeconds : 0.0;
+  GuiLabel(line, TextFormat("Points/s: %.2f M", pointsPerSecond / 1e6));
+  line.y += PERF_OVERLAY_LINE;
+  GuiLabel(line, TextFormat("Faces: %d", state->faceCount));
+  line.y += PERF_OVERLAY_LINE;
+  GuiLabel(line, TextFormat("Memory: %.2f MiB", GetPerfOverlayMemoryInUse() / (1024.0 * 1024.0)));
+  line.y += PERF_OVERLAY_LINE;
+
+  GuiLabel(line, TextFormat("Frame: %.2f ms", fGraphLast(&state->frameGraph)));
+  line.y += PERF_OVERLAY_LINE;
+  fDrawGraph((Rectangle){ line.x, line.y, line.width, PERF_OVERLAY_GRAPH_HEIGHT }, &state->frameGraph, MAROON);
+  line.y += PERF_OVERLAY_GRAPH_HEIGHT + 4;
+
+  GuiLabel(line, TextFormat("Builds: %.2f ms", fGraphLast(&state->buildGraph)));
+  line.y += PERF_OVERLAY_LINE;
+  fDrawGraph((Rectangle){ line.x, line.y, line.width, PERF_OVERLAY_GRAPH_HEIGHT }, &state->buildGraph, DARKBLUE);
+}
@@ -0,0 +1,34 @@
+#ifndef PERF_OVERLAY_H_
+#define PERF_OVERLAY_H_
+#include "raylib.h"
+#include "hull_worker.h"
+
+// Samples kept for the rolling graphs
+#define PERF_OVERLAY_HISTORY 120
+
+typedef struct PerfOverlayGraph {
+  float values[PERF_OVERLAY_HISTORY]; // Milliseconds, ring buffer
+  int count;
+  int next;
+} PerfOverlayGraph;
+
+typedef struct PerfOverlayState {
+  Rectangle bounds;
+  PerfOverlayGraph frameGraph;
+  PerfOverlayGraph buildGraph;  // One sample per finished build
+  int buildPoints;              // Last finished build
+  double buildSeconds;
+  double phaseSeconds[HULL_PHASE_COUNT];
+  int faceCount;                // Faces of the shown hull
+} PerfOverlayState;
+
+// Counts the bytes the hull library holds, call it before any hull object is created
+void InstallPerfOverlayAllocator(void);
+size_t GetPerfOverlayMemoryInUse(void);
+
+PerfOverlayState InitPerfOverlayState(Rectangle bounds);
+void PerfOverlayAddFrame(PerfOverlayState *state, float frameSeconds);
+void PerfOverlayAddBuild(PerfOverlayState *state, const HullWorkerResult *result);
+void PerfOverlayLayout(PerfOverlayState *state);
+
+#endif
@@ -0,0 +1,97 @@
+#include "point_cloud.h"
+#include <stdlib.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+// False when neither huge pages nor the heap have the memory, points is NULL then
+static bool fAllocate(PointCloud *cloud, int capacity)
+{
+  size_t bytes = sizeof(HullVec3) * (size_t)(capacity > 0 ? capacity : 1);
+  cloud->capacity = capacity;
+  cloud->mapped = false;
+  cloud->mappedBytes = 0;
+
+#if defined(__linux__)
+  if (cloud->hugePages)
+  {
+    size_t mappedBytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    // Explicit huge pages need a reserved pool, fall back to transparent huge pages when there is none
+    void *memory = mmap(NULL, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory == MAP_FAILED)
+    {
+      memory = mmap(NULL, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (memory != MAP_FAILED)
+      {
+        madvise(memory, mappedBytes, MADV_HUGEPAGE);
+      }
+    }
+    if (memory != MAP_FAILED)
+    {
+      cloud->points = memory;
+      cloud->mapped = true;
+      cloud->mappedBytes = mappedBytes;
+      return true;
+    }
+    HullLog(HULL_LOG_WARNING, "POINTS: Huge page allocation failed, using the regular heap");
+  }
+#endif
+  cloud->points = HullMemRealloc(NULL, bytes); // Not cleared, that would touch every page up front
+  if (cloud->points == NULL)
+  {
+    HullLog(HULL_LOG_ERROR, "POINTS: Failed to allocate %d points", capacity);
+    cloud->capacity = 0;
+    return false;
+  }
+  return true;
+}
+
+static void fRelease(PointCloud *cloud)
+{
+#if defined(__linux__)
+  if (cloud->mapped)
+  {
+    munmap(cloud->points, cloud->mappedBytes);
+    cloud->points = NULL;
+    return;
+  }
+#endif
+  HullMemFree(cloud->points);
+  cloud->points = NULL;
+}
+
+PointCloud CreatePointCloud(int count, bool hugePages)
+{
+  PointCloud cloud = {0};
+  cloud.hugePages = hugePages;
+  cloud.count = fAllocate(&cloud, count) ? count : 0;
+  return cloud;
+}
+
+// Existing points are kept, new ones are left uninitialized
+bool ResizePointCloud(PointCloud *cloud, int count)
+{
+  if (count > cloud->capacity)
+  {
+    PointCloud grown = *cloud;
+    if (!fAllocate(&grown, count))
+    {
+      return false;
+    }
+    memcpy(grown.points, cloud->points, sizeof(HullVec3) * (size_t)cloud->count);
+    fRelease(cloud);
+    *cloud = grown;
+  }
+  cloud->count = count;
+  return true;
+}
+
+void ClearPointCloud(PointCloud *cloud)
+{
+  fRelease(cloud);
+  cloud->count = 0;
+  cloud->capacity = 0;
+}
@@ -0,0 +1,25 @@
+#ifndef POINT_CLOUD_H_
+#define POINT_CLOUD_H_
+#include "hull_core.h"
+#include <stddef.h>
+
+#define MAX_POINT_CLOUD_COUNT 100000000
+
+// Heap storage for the input points.
+// Large clouds can ask for huge pages, which cuts TLB misses when the hull walks the whole array.
+typedef struct PointCloud {
+  int count;
+  int capacity;
+  HullVec3 *points;
+  bool hugePages;     // Requested by the caller
+  bool mapped;        // Storage comes from mmap instead of the heap
+  size_t mappedBytes;
+} PointCloud;
+
+// points is NULL and count 0 when the memory could not be allocated
+PointCloud CreatePointCloud(int count, bool hugePages);
+// False when the larger storage could not be allocated, the cloud is left as it was
+bool ResizePointCloud(PointCloud *cloud, int count);
+void ClearPointCloud(PointCloud *cloud);
+
+#endif
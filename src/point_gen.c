@@ -0,0 +1,209 @@
+#include "point_gen.h"
+#include "hull_parallel.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Counters reserved per point, each (seed, point, draw) triple is its own counter
+#define DRAWS_PER_POINT 8
+// Points generated together, their uniforms are drawn first in fixed length loops
+#define POINT_GEN_BLOCK 256
+
+static const char *distributionNames[POINTS_DISTRIBUTION_COUNT] = {
+  "cube", "ball", "sphere", "gaussian", "clustered", "coplanar", "collinear"
+};
+
+typedef struct PointGenContext {
+  HullVec3 *v;
+  PointDistribution distribution;
+  uint64_t key;
+  float extent;
+  HullVec3 axisU;     // Plane / line directions for the degenerate distributions
+  HullVec3 axisV;
+  HullVec3 clusterCenters[POINT_GEN_CLUSTER_COUNT];
+} PointGenContext;
+
+// SplitMix64 evaluated at an arbitrary position, which makes it a counter-based generator
+static inline uint64_t fMix64(uint64_t x)
+{
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static inline float fUniform(uint64_t key, uint64_t counter)
+{
+  // 24 random bits -> [0, 1)
+  return (float)(fMix64(key + counter * 0x9E3779B97F4A7C15ULL) >> 40) * (1.0f / 16777216.0f);
+}
+
+static inline float fSigned(uint64_t key, uint64_t counter)
+{
+  return fUniform(key, counter) * 2.0f - 1.0f;
+}
+
+// Box-Muller, each pair of uniforms gives two standard normal values
+static HullVec3 fBoxMuller(float u0, float u1, float u2, float u3)
+{
+  float r0 = sqrtf(-2.0f * logf(1.0f - u0)); // 1 - u is in (0, 1], log(0) is never taken
+  float a0 = 2.0f * HULL_PI * u1;
+  float r1 = sqrtf(-2.0f * logf(1.0f - u2));
+  float a1 = 2.0f * HULL_PI * u3;
+  return (HullVec3){ r0 * cosf(a0), r0 * sinf(a0), r1 * cosf(a1) };
+}
+
+// Counters counter .. counter + 3
+static HullVec3 fNormal3(uint64_t key, uint64_t counter)
+{
+  return fBoxMuller(fUniform(key, counter), fUniform(key, counter + 1), fUniform(key, counter + 2), fUniform(key, counter + 3));
+}
+
+// Uniforms of the draws 0 .. drawCount - 1 of the points first .. first + POINT_GEN_BLOCK - 1, the same values
+// as fUniform. One loop hashes and one converts per draw, both over the whole block so the trip count is fixed:
+// -O2 vectorizes the conversion, the hashing needs 64 bit vector multiplies (-O3 -march=x86-64-v3 does both).
+static void fDrawBlock(uint64_t key, int first, int drawCount, float uniforms[][POINT_GEN_BLOCK])
+{
+  uint32_t bits[POINT_GEN_BLOCK];
+  for (int d = 0; d < drawCount; d++)
+  {
+    uint64_t counter = (uint64_t)first * DRAWS_PER_POINT + (uint64_t)d;
+    for (int j = 0; j < POINT_GEN_BLOCK; j++)
+    {
+      bits[j] = (uint32_t)(fMix64(key + (counter + (uint64_t)j * DRAWS_PER_POINT) * 0x9E3779B97F4A7C15ULL) >> 40);
+    }
+    for (int j = 0; j < POINT_GEN_BLOCK; j++)
+    {
+      uniforms[d][j] = (float)bits[j] * (1.0f / 16777216.0f);
+    }
+  }
+}
+
+static void fGenerateRange(void *context, int begin, int end)
+{
+  static const int drawCounts[POINTS_DISTRIBUTION_COUNT] = { 3, 5, 4, 4, 5, 2, 1 };
+  PointGenContext *ctx = (PointGenContext *)context;
+  float extent = ctx->extent;
+  float u[DRAWS_PER_POINT][POINT_GEN_BLOCK];
+  float x[POINT_GEN_BLOCK], y[POINT_GEN_BLOCK], z[POINT_GEN_BLOCK];
+  if (ctx->distribution < 0 || ctx->distribution >= POINTS_DISTRIBUTION_COUNT)
+  {
+    return;
+  }
+
+  for (int first = begin; first < end; first += POINT_GEN_BLOCK)
+  {
+    int count = end - first < POINT_GEN_BLOCK ? end - first : POINT_GEN_BLOCK;
+    fDrawBlock(ctx->key, first, drawCounts[ctx->distribution], u);
+    switch (ctx->distribution)
+    {
+    case POINTS_UNIFORM_CUBE:
+      for (int j = 0; j < POINT_GEN_BLOCK; j++)
+      {
+        x[j] = (u[0][j] * 2.0f - 1.0f) * extent;
+        y[j] = (u[1][j] * 2.0f - 1.0f) * extent;
+        z[j] = (u[2][j] * 2.0f - 1.0f) * extent;
+      }
+      break;
+    case POINTS_COPLANAR:
+      for (int j = 0; j < POINT_GEN_BLOCK; j++)
+      {
+        // Scaled by 1 / sqrt(2) so the plane stays within the cube
+        float a = (u[0][j] * 2.0f - 1.0f) * extent * 0.70710678f;
+        float b = (u[1][j] * 2.0f - 1.0f) * extent * 0.70710678f;
+        x[j] = ctx->axisU.x * a + ctx->axisV.x * b;
+        y[j] = ctx->axisU.y * a + ctx->axisV.y * b;
+        z[j] = ctx->axisU.z * a + ctx->axisV.z * b;
+      }
+      break;
+    case POINTS_COLLINEAR:
+      for (int j = 0; j < POINT_GEN_BLOCK; j++)
+      {
+        float t = (u[0][j] * 2.0f - 1.0f) * extent;
+        x[j] = ctx->axisU.x * t;
+        y[j] = ctx->axisU.y * t;
+        z[j] = ctx->axisU.z * t;
+      }
+      break;
+    default:
+      // Box-Muller needs log, sin and cos, which stay scalar without a vector math library
+      for (int j = 0; j < count; j++)
+      {
+        HullVec3 normal = fBoxMuller(u[0][j], u[1][j], u[2][j], u[3][j]);
+        HullVec3 p;
+        if (ctx->distribution == POINTS_UNIFORM_BALL)
+        {
+          // Uniform direction, radius scaled by the cube root for a uniform volume density
+          p = HullVec3Scale(HullVec3Normalize(normal), cbrtf(u[4][j]) * extent);
+        }
+        else if (ctx->distribution == POINTS_SPHERE_SURFACE)
+        {
+          p = HullVec3Scale(HullVec3Normalize(normal), extent);
+        }
+        else if (ctx->distribution == POINTS_GAUSSIAN)
+        {
+          p = HullVec3Scale(normal, extent / 3.0f);
+        }
+        else
+        {
+          int cluster = (int)(u[4][j] * POINT_GEN_CLUSTER_COUNT);
+          p = HullVec3Add(ctx->clusterCenters[cluster], HullVec3Scale(normal, extent / 15.0f));
+        }
+        x[j] = p.x;
+        y[j] = p.y;
+        z[j] = p.z;
+      }
+      break;
+    }
+    for (int j = 0; j < count; j++)
+    {
+      ctx->v[first + j] = (HullVec3){ x[j], y[j], z[j] };
+    }
+  }
+}
+
+void GeneratePoints(HullVec3 v[], int n, PointDistribution distribution, unsigned int seed, float extent, int threadCount)
+{
+  PointGenContext ctx = {0};
+  ctx.v = v;
+  ctx.distribution = distribution;
+  ctx.key = fMix64((uint64_t)seed + 0x632BE59BD9B4E019ULL);
+  ctx.extent = extent;
+
+  // Shared parameters use their own key, so they neither depend on n nor collide with point draws
+  uint64_t sharedKey = fMix64(ctx.key ^ 0xD1B54A32D192ED03ULL);
+  ctx.axisU = HullVec3Normalize(fNormal3(sharedKey, 0));
+  HullVec3 other = HullVec3Normalize(fNormal3(sharedKey, 4));
+  ctx.axisV = HullVec3Normalize(HullVec3CrossProduct(ctx.axisU, other));
+  for (int k = 0; k < POINT_GEN_CLUSTER_COUNT; k++)
+  {
+    uint64_t c = 12 + (uint64_t)k * 3;
+    ctx.clusterCenters[k] = (HullVec3){
+      fSigned(sharedKey, c) * extent * 0.75f,
+      fSigned(sharedKey, c + 1) * extent * 0.75f,
+      fSigned(sharedKey, c + 2) * extent * 0.75f
+    };
+  }
+
+  HullParallelFor(n, threadCount, fGenerateRange, &ctx);
+}
+
+const char *GetPointDistributionName(PointDistribution distribution)
+{
+  if (distribution < 0 || distribution >= POINTS_DISTRIBUTION_COUNT)
+  {
+    return "unknown";
+  }
+  return distributionNames[distribution];
+}
+
+PointDistribution GetPointDistributionFromName(const char *name)
+{
+  for (int i = 0; i < POINTS_DISTRIBUTION_COUNT; i++)
+  {
+    if (strcmp(name, distributionNames[i]) == 0)
+    {
+      return (PointDistribution)i;
+    }
+  }
+  return POINTS_DISTRIBUTION_COUNT;
+}
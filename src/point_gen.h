@@ -0,0 +1,26 @@
+#ifndef POINT_GEN_H_
+#define POINT_GEN_H_
+#include "hull_core.h"
+
+#define POINT_GEN_CLUSTER_COUNT 8
+
+typedef enum PointDistribution {
+  POINTS_UNIFORM_CUBE = 0,
+  POINTS_UNIFORM_BALL,
+  POINTS_SPHERE_SURFACE,  // Every point is a hull vertex
+  POINTS_GAUSSIAN,
+  POINTS_CLUSTERED,
+  POINTS_COPLANAR,        // On a tilted plane, only coplanar up to float rounding
+  POINTS_COLLINEAR,       // On a tilted line, only collinear up to float rounding
+  POINTS_DISTRIBUTION_COUNT
+} PointDistribution;
+
+// Fills v with n points within [-extent, extent]^3, except for the Gaussian tails (extent is 3 sigma)
+// and cluster edges.
+// Every point only depends on (seed, index), so the output is identical for any thread count.
+void GeneratePoints(HullVec3 v[], int n, PointDistribution distribution, unsigned int seed, float extent, int threadCount);
+const char *GetPointDistributionName(PointDistribution distribution);
+// Returns POINTS_DISTRIBUTION_COUNT when the name is unknown
+PointDistribution GetPointDistributionFromName(const char *name);
+
+#endif
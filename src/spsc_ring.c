@@ -0,0 +1,56 @@
+#include "spsc_ring.h"
+#include "hull_core.h"
+#include <stddef.h>
+
+void SpscRingInit(SpscRing *ring, int capacity)
+{
+  int powerOfTwo = 1;
+  while (powerOfTwo < capacity)
+  {
+    powerOfTwo *= 2;
+  }
+  ring->capacity = powerOfTwo;
+  ring->slots = HullMemAlloc(sizeof(void *) * powerOfTwo);
+  atomic_init(&ring->head, 0);
+  atomic_init(&ring->tail, 0);
+}
+
+bool SpscRingPush(SpscRing *ring, void *data)
+{
+  unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+  unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+  if (tail - head == (unsigned int)ring->capacity)
+  {
+    return false; // Full
+  }
+  ring->slots[tail & (ring->capacity - 1)] = data;
+  // Release publishes the slot before the consumer can see the new tail
+  atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+  return true;
+}
+
+void *SpscRingPop(SpscRing *ring)
+{
+  unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+  unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+  if (head == tail)
+  {
+    return NULL; // Empty
+  }
+  void *data = ring->slots[head & (ring->capacity - 1)];
+  atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+  return data;
+}
+
+bool SpscRingIsEmpty(SpscRing *ring)
+{
+  return atomic_load_explicit(&ring->head, memory_order_acquire) == atomic_load_explicit(&ring->tail, memory_order_acquire);
+}
+
+void SpscRingClear(SpscRing *ring)
+{
+  // NOTE: Only the slot array is released, the pointers left in it belong to the caller
+  HullMemFree(ring->slots);
+  ring->slots = NULL;
+  ring->capacity = 0;
+}
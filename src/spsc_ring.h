@@ -0,0 +1,21 @@
+#ifndef SPSC_RING_H_
+#define SPSC_RING_H_
+#include <stdatomic.h>
+#include <stdbool.h>
+
+// Lock-free single-producer / single-consumer ring of pointers.
+// Exactly one thread may push and exactly one (other) thread may pop.
+typedef struct SpscRing {
+  int capacity;            // Power of two
+  void **slots;
+  atomic_uint head;        // Next slot to pop, written by the consumer
+  atomic_uint tail;        // Next slot to push, written by the producer
+} SpscRing;
+
+void SpscRingInit(SpscRing *ring, int capacity);
+bool SpscRingPush(SpscRing *ring, void *data);
+void *SpscRingPop(SpscRing *ring);
+bool SpscRingIsEmpty(SpscRing *ring);
+void SpscRingClear(SpscRing *ring);
+
+#endif
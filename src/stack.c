@@ -1,17 +1,17 @@
 #include "stack.h"
-#include "raylib.h"
+#include "hull_core.h"
 #include "stddef.h"
 
 Stack *StackNew()
 {
-  Stack *newStack = (Stack*) MemAlloc(sizeof(Stack));
+  Stack *newStack = (Stack*) HullMemAlloc(sizeof(Stack));
   *newStack = (Stack){0, NULL, NULL};
   return newStack;
 }
 
 StackSNode *StackNewNode(void *data)
 {
-  StackSNode *newNode = (StackSNode*) MemAlloc(sizeof(StackSNode));
+  StackSNode *newNode = (StackSNode*) HullMemAlloc(sizeof(StackSNode));
   *newNode = (StackSNode){data, NULL};
   return newNode;
 }
@@ -36,8 +36,8 @@ void StackPopBack(Stack* stack){
   }
 
   if (stack->head == stack->tail){
-    MemFree(stack->head->data);
-    MemFree(stack->head);
+    HullMemFree(stack->head->data);
+    HullMemFree(stack->head);
     stack->head = NULL;
     stack->tail = NULL;
     stack->size = 0;
@@ -70,8 +70,8 @@ void StackClear(Stack *stack)
   {
     StackSNode *temp = current;
     current = current->next;
-    MemFree(temp->data);
-    MemFree(temp);
+    HullMemFree(temp->data);
+    HullMemFree(temp);
   }
   stack->head = NULL;
   stack->tail = NULL;
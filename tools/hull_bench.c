@@ -0,0 +1,658 @@
+// Hull construction benchmark: every engine x distribution x size, results as JSON.
+// Memory is measured through the hull allocator hooks, so only hull allocations are counted.
+// With --baseline the run is compared against an earlier output and fails on slowdowns.
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_build.h"
+#include "hull_perf.h"
+#include "hull_time.h"
+#include "point_cloud.h"
+#include "point_gen.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_MAX_SIZES 16
+#define BENCH_DEFAULT_REPEAT 5
+#define BENCH_DEFAULT_WARMUP 1
+#define BENCH_DEFAULT_SEED 8742
+#define BENCH_EXTENT 5.0f
+// The incremental engine tests every face per insertion, past this it takes hours
+#define BENCH_DEFAULT_INCREMENTAL_MAX 10000
+#define BENCH_DEFAULT_THRESHOLD 5.0
+#define BENCH_BOOTSTRAP_ROUNDS 2000
+#define BENCH_MAX_LINE (1024 * 1024)
+// Exit code when a scenario regressed, usage and I/O errors exit with 1
+#define BENCH_EXIT_REGRESSION 2
+
+static const char *engineNames[HULL_ENGINE_COUNT] = { "incremental", "conflict" };
+
+//------------------------------------------------------------------------------------
+// Counting allocator
+//------------------------------------------------------------------------------------
+typedef struct BenchAllocHeader {
+  size_t size;
+  size_t padding; // Keeps the user block 16-byte aligned
+} BenchAllocHeader;
+
+typedef struct BenchMemory {
+  size_t currentBytes;
+  size_t peakBytes;
+  long long allocations;
+} BenchMemory;
+
+static void *fBenchAlloc(size_t size, void *user)
+{
+  BenchMemory *memory = user;
+  BenchAllocHeader *header = malloc(sizeof(BenchAllocHeader) + size);
+  if (header == NULL) return NULL;
+  header->size = size;
+  memory->currentBytes += size;
+  if (memory->currentBytes > memory->peakBytes) memory->peakBytes = memory->currentBytes;
+  memory->allocations++;
+  return header + 1;
+}
+
+static void *fBenchRealloc(void *ptr, size_t size, void *user)
+{
+  if (ptr == NULL) return fBenchAlloc(size, user);
+
+  BenchMemory *memory = user;
+  BenchAllocHeader *header = (BenchAllocHeader *)ptr - 1;
+  size_t oldSize = header->size;
+  header = realloc(header, sizeof(BenchAllocHeader) + size);
+  if (header == NULL) return NULL;
+  header->size = size;
+  memory->currentBytes = memory->currentBytes - oldSize + size;
+  if (memory->currentBytes > memory->peakBytes) memory->peakBytes = memory->currentBytes;
+  memory->allocations++;
+  return header + 1;
+}
+
+static void fBenchFree(void *ptr, void *user)
+{
+  BenchMemory *memory = user;
+  BenchAllocHeader *header = (BenchAllocHeader *)ptr - 1;
+  memory->currentBytes -= header->size;
+  free(header);
+}
+
+//------------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------------
+static int fCompareDoubles(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Linear interpolation between the closest ranks, samples must be sorted
+static double fPercentile(const double *samples, int count, double percentile)
+{
+  if (count == 1) return samples[0];
+  double rank = percentile / 100.0 * (count - 1);
+  int low = (int)rank;
+  if (low >= count - 1) return samples[count - 1];
+  double t = rank - low;
+  return samples[low] * (1.0 - t) + samples[low + 1] * t;
+}
+
+static double fMedian(double *samples, int count)
+{
+  qsort(samples, count, sizeof(double), fCompareDoubles);
+  return fPercentile(samples, count, 50.0);
+}
+
+static uint64_t fNextRandom(uint64_t *state)
+{
+  // SplitMix64
+  uint64_t x = (*state += 0x9E3779B97F4A7C15ULL);
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static double fResampledMedian(const double *samples, int count, double *scratch, uint64_t *state)
+{
+  for (int i = 0; i < count; i++)
+  {
+    scratch[i] = samples[fNextRandom(state) % (uint64_t)count];
+  }
+  return fMedian(scratch, count);
+}
+
+// 95% bootstrap interval of the relative change between the medians, in percent.
+// Timings are skewed and have outliers, resampling the medians makes no normality assumption.
+static void fBootstrapChange(const double *base, int baseCount, const double *current, int currentCount, double *low, double *high)
+{
+  double *changes = malloc(sizeof(double) * BENCH_BOOTSTRAP_ROUNDS);
+  double *scratch = malloc(sizeof(double) * (baseCount > currentCount ? baseCount : currentCount));
+  uint64_t state = 0x5EEDULL; // Fixed, the same inputs always give the same verdict
+  for (int round = 0; round < BENCH_BOOTSTRAP_ROUNDS; round++)
+  {
+    double baseMedian = fResampledMedian(base, baseCount, scratch, &state);
+    double currentMedian = fResampledMedian(current, currentCount, scratch, &state);
+    changes[round] = baseMedian > 0.0 ? (currentMedian / baseMedian - 1.0) * 100.0 : 0.0;
+  }
+  qsort(changes, BENCH_BOOTSTRAP_ROUNDS, sizeof(double), fCompareDoubles);
+  *low = fPercentile(changes, BENCH_BOOTSTRAP_ROUNDS, 2.5);
+  *high = fPercentile(changes, BENCH_BOOTSTRAP_ROUNDS, 97.5);
+  free(scratch);
+  free(changes);
+}
+
+//------------------------------------------------------------------------------------
+// Baseline, read back from an earlier hull_bench output
+//------------------------------------------------------------------------------------
+typedef struct BenchBaseline {
+  char engine[32];
+  char distribution[32];
+  int points;
+  int sampleCount;
+  double *samples;
+  double phaseMedian[HULL_PHASE_COUNT];
+} BenchBaseline;
+
+// NOTE: Not a JSON parser, it relies on hull_bench writing one result per line with unique keys
+static const char *fJsonValue(const char *line, const char *key)
+{
+  char pattern[64];
+  snprintf(pattern, sizeof(pattern), "\"%s\": ", key);
+  const char *found = strstr(line, pattern);
+  return found != NULL ? found + strlen(pattern) : NULL;
+}
+
+static bool fJsonString(const char *line, const char *key, char *out, int size)
+{
+  const char *value = fJsonValue(line, key);
+  if (value == NULL || *value != '"') return false;
+  value++;
+  int length = 0;
+  while (value[length] != '"' && value[length] != '\0' && length < size - 1) length++;
+  memcpy(out, value, length);
+  out[length] = '\0';
+  return true;
+}
+
+static bool fJsonNumber(const char *line, const char *key, double *out)
+{
+  const char *value = fJsonValue(line, key);
+  if (value == NULL) return false;
+  char *end;
+  *out = strtod(value, &end);
+  return end != value;
+}
+
+// Returns the number of values read from a flat number array, the array is malloc'ed
+static int fJsonNumbers(const char *line, const char *key, double **out)
+{
+  const char *value = fJsonValue(line, key);
+  if (value == NULL || *value != '[') return 0;
+
+  int capacity = 16;
+  int count = 0;
+  double *values = malloc(sizeof(double) * capacity);
+  const char *cursor = value + 1;
+  while (true)
+  {
+    char *end;
+    double number = strtod(cursor, &end);
+    if (end == cursor) break;
+    if (count == capacity)
+    {
+      capacity *= 2;
+      values = realloc(values, sizeof(double) * capacity);
+    }
+    values[count++] = number;
+    cursor = end;
+    while (*cursor == ',' || *cursor == ' ') cursor++;
+  }
+  *out = values;
+  return count;
+}
+
+static BenchBaseline *fLoadBaseline(const char *fileName, int *baselineCount)
+{
+  FILE *file = fopen(fileName, "r");
+  if (file == NULL) return NULL;
+
+  char *line = malloc(BENCH_MAX_LINE);
+  int capacity = 64;
+  int count = 0;
+  BenchBaseline *baselines = malloc(sizeof(BenchBaseline) * capacity);
+  while (fgets(line, BENCH_MAX_LINE, file) != NULL)
+  {
+    BenchBaseline baseline = { 0 };
+    double points;
+    if (!fJsonString(line, "engine", baseline.engine, sizeof(baseline.engine))
+      || !fJsonString(line, "distribution", baseline.distribution, sizeof(baseline.distribution))
+      || !fJsonNumber(line, "points", &points))
+    {
+      continue;
+    }
+    baseline.points = (int)points;
+    baseline.sampleCount = fJsonNumbers(line, "samplesMs", &baseline.samples);
+    if (baseline.sampleCount == 0)
+    {
+      free(baseline.samples);
+      continue;
+    }
+    for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+    {
+      if (!fJsonNumber(line, GetHullPhaseName(phase), &baseline.phaseMedian[phase])) baseline.phaseMedian[phase] = -1.0;
+    }
+    if (count == capacity)
+    {
+      capacity *= 2;
+      baselines = realloc(baselines, sizeof(BenchBaseline) * capacity);
+    }
+    baselines[count++] = baseline;
+  }
+  free(line);
+  fclose(file);
+  *baselineCount = count;
+  return baselines;
+}
+
+static BenchBaseline *fFindBaseline(BenchBaseline *baselines, int count, const char *engine, const char *distribution, int points)
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (baselines[i].points == points && strcmp(baselines[i].engine, engine) == 0 && strcmp(baselines[i].distribution, distribution) == 0)
+    {
+      return &baselines[i];
+    }
+  }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------------
+// Benchmark
+//------------------------------------------------------------------------------------
+typedef struct BenchOptions {
+  int sizes[BENCH_MAX_SIZES];
+  int sizeCount;
+  bool engines[HULL_ENGINE_COUNT];
+  bool distributions[POINTS_DISTRIBUTION_COUNT];
+  int repeat;
+  int warmup;
+  unsigned int seed;
+  int incrementalMax;
+  int threadCount;
+  const char *outputFile;
+  const char *baselineFile;
+  double threshold;     // Percent
+  bool perf;            // Hardware counters per phase
+  bool spatialOrder;    // Builds insert in HullBuildSpatialOrder's order
+} BenchOptions;
+
+typedef struct BenchResult {
+  double *millis;       // One per run, sorted after the scenario
+  double *phaseMillis[HULL_PHASE_COUNT];
+  double *phaseCounters[HULL_PHASE_COUNT][HULL_PERF_COUNTER_COUNT]; // Per run, negative when unavailable
+  int triangleCount;
+  size_t peakBytes;     // Largest over the runs
+  long long allocations;
+  HullBuildStats stats; // Counters do not depend on the run, the last one is kept
+} BenchResult;
+
+static void fRunScenario(BenchMemory *memory, HullPerf *perf, HullVec3 *points, int count, HullEngine engine, const BenchOptions *options, BenchResult *result)
+{
+  for (int run = -options->warmup; run < options->repeat; run++)
+  {
+    size_t baseBytes = memory->currentBytes;
+    memory->peakBytes = baseBytes;
+    memory->allocations = 0;
+
+    double start = HullTimeNow();
+    HullBuild *build = HullBuildBeginEx(points, count, engine, perf);
+    if (options->spatialOrder)
+    {
+      HullBuildSpatialOrder(build, options->threadCount);
+    }
+    HullBuildStep(build, -1);
+    ConvexShape *convexShape = HullBuildSnapshot(build);
+    double phaseSeconds[HULL_PHASE_COUNT];
+    HullPerfSample phaseCounters[HULL_PHASE_COUNT];
+    memcpy(phaseSeconds, build->phaseSeconds, sizeof(phaseSeconds));
+    memcpy(phaseCounters, build->phaseCounters, sizeof(phaseCounters));
+    result->stats = build->stats;
+    HullBuildEnd(build);
+    double elapsed = HullTimeNow() - start;
+
+    if (run >= 0)
+    {
+      result->millis[run] = elapsed * 1000.0;
+      for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+      {
+        result->phaseMillis[phase][run] = phaseSeconds[phase] * 1000.0;
+        for (int counter = 0; perf != NULL && counter < HULL_PERF_COUNTER_COUNT; counter++)
+        {
+          result->phaseCounters[phase][counter][run] = (double)phaseCounters[phase].values[counter];
+        }
+      }
+      if (memory->peakBytes - baseBytes > result->peakBytes) result->peakBytes = memory->peakBytes - baseBytes;
+      result->allocations = memory->allocations;
+      result->triangleCount = convexShape != NULL ? convexShape->triangleCount : 0;
+    }
+    ClearConvexShape(convexShape);
+    HullMemFree(convexShape);
+  }
+  qsort(result->millis, options->repeat, sizeof(double), fCompareDoubles);
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    qsort(result->phaseMillis[phase], options->repeat, sizeof(double), fCompareDoubles);
+  }
+}
+
+// Writes the "baseline" member of a result and returns true when the scenario regressed.
+// A regression needs the whole confidence interval above the threshold, so noise alone does not fail a run.
+static bool fWriteComparison(FILE *out, const char *name, const BenchOptions *options, const BenchResult *result, const BenchBaseline *baseline)
+{
+  int runs = options->repeat;
+  double median = fPercentile(result->millis, runs, 50.0);
+  double baseMedian = fPercentile(baseline->samples, baseline->sampleCount, 50.0);
+  double change = baseMedian > 0.0 ? (median / baseMedian - 1.0) * 100.0 : 0.0;
+  double low, high;
+  fBootstrapChange(baseline->samples, baseline->sampleCount, result->millis, runs, &low, &high);
+  bool regression = low > options->threshold;
+
+  fprintf(out, ", \"baseline\": {\"medianMs\": %.4f, \"changePercent\": %.2f, \"ciLowPercent\": %.2f, \"ciHighPercent\": %.2f, \"regression\": %s, \"phaseChangePercent\": {",
+    baseMedian, change, low, high, regression ? "true" : "false");
+  fprintf(stderr, "%-40s %10.3f -> %10.3f ms %+7.1f%% [%+.1f, %+.1f]%s\n", name, baseMedian, median, change, low, high, regression ? "  REGRESSION" : "");
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    double basePhase = baseline->phaseMedian[phase];
+    double phaseMedian = fPercentile(result->phaseMillis[phase], runs, 50.0);
+    fprintf(out, "%s\"%s\": ", phase > 0 ? ", " : "", GetHullPhaseName(phase));
+    if (basePhase > 0.0) fprintf(out, "%.2f", (phaseMedian / basePhase - 1.0) * 100.0);
+    else fprintf(out, "null");
+    fprintf(stderr, "    %-16s %10.3f -> %10.3f ms\n", GetHullPhaseName(phase), basePhase, phaseMedian);
+  }
+  fprintf(out, "}}");
+  return regression;
+}
+
+static void fWriteResult(FILE *out, bool first, HullEngine engine, PointDistribution distribution, int count, const BenchOptions *options, const BenchResult *result)
+{
+  const double *ms = result->millis;
+  int runs = options->repeat;
+  double median = fPercentile(ms, runs, 50.0);
+  fprintf(out, "%s\n    {\"engine\": \"%s\", \"distribution\": \"%s\", \"points\": %d, \"runs\": %d, ",
+    first ? "" : ",", engineNames[engine], GetPointDistributionName(distribution), count, runs);
+  fprintf(out, "\"minMs\": %.4f, \"medianMs\": %.4f, \"p90Ms\": %.4f, \"p99Ms\": %.4f, \"maxMs\": %.4f, ",
+    ms[0], median, fPercentile(ms, runs, 90.0), fPercentile(ms, runs, 99.0), ms[runs - 1]);
+  fprintf(out, "\"pointsPerSecond\": %.1f, \"peakBytes\": %zu, \"allocations\": %lld, \"triangles\": %d, ",
+    median > 0.0 ? count / (median / 1000.0) : 0.0, result->peakBytes, result->allocations, result->triangleCount);
+  fprintf(out, "\"phaseMedianMs\": {");
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    fprintf(out, "%s\"%s\": %.4f", phase > 0 ? ", " : "", GetHullPhaseName(phase), fPercentile(result->phaseMillis[phase], runs, 50.0));
+  }
+  fprintf(out, "}, \"samplesMs\": [");
+  for (int run = 0; run < runs; run++)
+  {
+    fprintf(out, "%s%.4f", run > 0 ? ", " : "", ms[run]);
+  }
+  fprintf(out, "]");
+}
+
+// Median counts per phase, null for counters that were not available in every run
+static void fWriteCounters(FILE *out, int runs, BenchResult *result)
+{
+  fprintf(out, ", \"phaseCounters\": {");
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    fprintf(out, "%s\"%s\": {", phase > 0 ? ", " : "", GetHullPhaseName(phase));
+    for (int counter = 0; counter < HULL_PERF_COUNTER_COUNT; counter++)
+    {
+      double *values = result->phaseCounters[phase][counter];
+      double median = fMedian(values, runs);
+      fprintf(out, "%s\"%s\": ", counter > 0 ? ", " : "", GetHullPerfCounterName(counter));
+      if (values[0] < 0.0) fprintf(out, "null");
+      else fprintf(out, "%.0f", median);
+    }
+    fprintf(out, "}");
+  }
+  fprintf(out, "}");
+}
+
+static void fWriteStats(FILE *out, const HullBuildStats *stats)
+{
+  fprintf(out, ", \"stats\": {\"canSeeTests\": %lld, \"insertions\": %lld, \"visibleFaces\": %lld, \"maxVisibleFaces\": %d, ",
+    stats->canSeeTests, stats->insertions, stats->visibleFaces, stats->maxVisibleFaces);
+  fprintf(out, "\"horizonEdges\": %lld, \"facesCreated\": %lld, \"facesDestroyed\": %lld, \"interiorPoints\": %lld, \"peakLiveFaces\": %lld, ",
+    stats->horizonEdges, stats->facesCreated, stats->facesDestroyed, stats->interiorPoints, stats->peakLiveFaces);
+  // Trailing empty buckets are left out
+  int bucketCount = HULL_STATS_HORIZON_BUCKETS;
+  while (bucketCount > 0 && stats->horizonHistogram[bucketCount - 1] == 0) bucketCount--;
+  fprintf(out, "\"horizonHistogram\": [");
+  for (int i = 0; i < bucketCount; i++)
+  {
+    fprintf(out, "%s%lld", i > 0 ? ", " : "", stats->horizonHistogram[i]);
+  }
+  fprintf(out, "]}");
+}
+
+static void fPrintUsage(const char *program)
+{
+  fprintf(stderr,
+    "usage: %s [options]\n"
+    "  --sizes <n,n,...>          point counts (default 100,1000,...,10000000)\n"
+    "  --engines <name,...>       incremental,conflict (default both)\n"
+    "  --distributions <name,...> cube,ball,sphere,gaussian,clustered,coplanar,collinear (default all)\n"
+    "  --repeat <n>               timed runs per scenario (default %d)\n"
+    "  --warmup <n>               untimed runs before them (default %d)\n"
+    "  --seed <n>                 point seed (default %d)\n"
+    "  --incremental-max <n>      largest size run with the incremental engine (default %d)\n"
+    "  --threads <n>              threads used to generate and order points, 0 = every core\n"
+    "  -o, --output <file>        write the JSON there instead of stdout\n"
+    "  --baseline <file>          compare against an earlier output, exits with %d on a regression\n"
+    "  --threshold <percent>      slowdown that counts as a regression (default %.0f)\n"
+    "  --perf                     hardware counters per phase (Linux perf_event_open)\n"
+    "  --spatial-order            insert the points in spatial order (HullBuildSpatialOrder)\n",
+    program, BENCH_DEFAULT_REPEAT, BENCH_DEFAULT_WARMUP, BENCH_DEFAULT_SEED, BENCH_DEFAULT_INCREMENTAL_MAX,
+    BENCH_EXIT_REGRESSION, BENCH_DEFAULT_THRESHOLD);
+}
+
+// Marks every comma separated name found in names, returns false on an unknown one
+static bool fParseNameList(char *list, const char *const names[], int nameCount, bool selected[])
+{
+  memset(selected, 0, sizeof(bool) * nameCount);
+  for (char *name = strtok(list, ","); name != NULL; name = strtok(NULL, ","))
+  {
+    int found = -1;
+    for (int i = 0; i < nameCount; i++)
+    {
+      if (strcmp(name, names[i]) == 0) found = i;
+    }
+    if (found < 0) return false;
+    selected[found] = true;
+  }
+  return true;
+}
+
+static bool fParseOptions(int argc, char **argv, BenchOptions *options)
+{
+  const char *distributionNames[POINTS_DISTRIBUTION_COUNT];
+  for (int i = 0; i < POINTS_DISTRIBUTION_COUNT; i++) distributionNames[i] = GetPointDistributionName(i);
+
+  *options = (BenchOptions){
+    .sizes = { 100, 1000, 10000, 100000, 1000000, 10000000 },
+    .sizeCount = 6,
+    .repeat = BENCH_DEFAULT_REPEAT,
+    .warmup = BENCH_DEFAULT_WARMUP,
+    .seed = BENCH_DEFAULT_SEED,
+    .incrementalMax = BENCH_DEFAULT_INCREMENTAL_MAX,
+    .threshold = BENCH_DEFAULT_THRESHOLD
+  };
+  for (int i = 0; i < HULL_ENGINE_COUNT; i++) options->engines[i] = true;
+  for (int i = 0; i < POINTS_DISTRIBUTION_COUNT; i++) options->distributions[i] = true;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--perf") == 0)
+    {
+      options->perf = true;
+      continue;
+    }
+    if (strcmp(argv[i], "--spatial-order") == 0)
+    {
+      options->spatialOrder = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    char *value = argv[++i];
+    const char *option = argv[i - 1];
+    if (strcmp(option, "--sizes") == 0)
+    {
+      options->sizeCount = 0;
+      for (char *size = strtok(value, ","); size != NULL && options->sizeCount < BENCH_MAX_SIZES; size = strtok(NULL, ","))
+      {
+        int count = atoi(size);
+        if (count < 4 || count > MAX_POINT_CLOUD_COUNT) return false;
+        options->sizes[options->sizeCount++] = count;
+      }
+    }
+    else if (strcmp(option, "--engines") == 0)
+    {
+      if (!fParseNameList(value, engineNames, HULL_ENGINE_COUNT, options->engines)) return false;
+    }
+    else if (strcmp(option, "--distributions") == 0)
+    {
+      if (!fParseNameList(value, distributionNames, POINTS_DISTRIBUTION_COUNT, options->distributions)) return false;
+    }
+    else if (strcmp(option, "--repeat") == 0) options->repeat = atoi(value);
+    else if (strcmp(option, "--warmup") == 0) options->warmup = atoi(value);
+    else if (strcmp(option, "--seed") == 0) options->seed = (unsigned int)strtoul(value, NULL, 10);
+    else if (strcmp(option, "--incremental-max") == 0) options->incrementalMax = atoi(value);
+    else if (strcmp(option, "--threads") == 0) options->threadCount = atoi(value);
+    else if (strcmp(option, "-o") == 0 || strcmp(option, "--output") == 0) options->outputFile = value;
+    else if (strcmp(option, "--baseline") == 0) options->baselineFile = value;
+    else if (strcmp(option, "--threshold") == 0) options->threshold = atof(value);
+    else return false;
+  }
+  return options->repeat > 0 && options->warmup >= 0 && options->sizeCount > 0;
+}
+
+int main(int argc, char **argv)
+{
+  BenchOptions options;
+  if (!fParseOptions(argc, argv, &options))
+  {
+    fPrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  int baselineCount = 0;
+  BenchBaseline *baselines = NULL;
+  if (options.baselineFile != NULL)
+  {
+    baselines = fLoadBaseline(options.baselineFile, &baselineCount);
+    if (baselines == NULL)
+    {
+      fprintf(stderr, "failed to read baseline %s\n", options.baselineFile);
+      return EXIT_FAILURE;
+    }
+  }
+
+  HullPerf *perf = NULL;
+  if (options.perf)
+  {
+    perf = HullPerfOpen();
+    if (perf->availableCount == 0)
+    {
+      fprintf(stderr, "no hardware counters available, check perf_event_paranoid\n");
+    }
+  }
+
+  BenchMemory memory = { 0 };
+  HullSetAllocator(&(HullAllocator){ fBenchAlloc, fBenchRealloc, fBenchFree, &memory });
+
+  FILE *out = options.outputFile != NULL ? fopen(options.outputFile, "w") : stdout;
+  if (out == NULL)
+  {
+    fprintf(stderr, "failed to open %s\n", options.outputFile);
+    return EXIT_FAILURE;
+  }
+  fprintf(out, "{\n  \"version\": 2,\n  \"seed\": %u,\n  \"repeat\": %d,\n  \"warmup\": %d,\n  \"incrementalMaxPoints\": %d,\n  \"spatialOrder\": %s,\n  \"results\": [",
+    options.seed, options.repeat, options.warmup, options.incrementalMax, options.spatialOrder ? "true" : "false");
+
+  BenchResult result = { .millis = malloc(sizeof(double) * options.repeat) };
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    result.phaseMillis[phase] = malloc(sizeof(double) * options.repeat);
+    for (int counter = 0; perf != NULL && counter < HULL_PERF_COUNTER_COUNT; counter++)
+    {
+      result.phaseCounters[phase][counter] = malloc(sizeof(double) * options.repeat);
+    }
+  }
+  bool first = true;
+  int regressions = 0;
+  for (int d = 0; d < POINTS_DISTRIBUTION_COUNT; d++)
+  {
+    if (!options.distributions[d]) continue;
+    for (int s = 0; s < options.sizeCount; s++)
+    {
+      int count = options.sizes[s];
+      PointCloud cloud = CreatePointCloud(count, false);
+      if (cloud.points == NULL)
+      {
+        fprintf(stderr, "not enough memory for %d points, size skipped\n", count);
+        continue;
+      }
+      GeneratePoints(cloud.points, count, (PointDistribution)d, options.seed, BENCH_EXTENT, options.threadCount);
+
+      for (int e = 0; e < HULL_ENGINE_COUNT; e++)
+      {
+        if (!options.engines[e] || (e == HULL_ENGINE_INCREMENTAL && count > options.incrementalMax)) continue;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s %s %d", engineNames[e], GetPointDistributionName(d), count);
+        fprintf(stderr, "%-40s ...", name);
+        result.peakBytes = 0;
+        fRunScenario(&memory, perf, cloud.points, count, (HullEngine)e, &options, &result);
+        fprintf(stderr, " %.3f ms\n", fPercentile(result.millis, options.repeat, 50.0));
+
+        fWriteResult(out, first, (HullEngine)e, (PointDistribution)d, count, &options, &result);
+        if (perf != NULL) fWriteCounters(out, options.repeat, &result);
+        if (HULL_STATS_ENABLED) fWriteStats(out, &result.stats);
+        BenchBaseline *baseline = fFindBaseline(baselines, baselineCount, engineNames[e], GetPointDistributionName(d), count);
+        if (baseline != NULL && fWriteComparison(out, name, &options, &result, baseline))
+        {
+          regressions++;
+        }
+        fprintf(out, "}");
+        fflush(out);
+        first = false;
+      }
+      ClearPointCloud(&cloud);
+    }
+  }
+  fprintf(out, "\n  ]\n}\n");
+  if (baselines != NULL)
+  {
+    fprintf(stderr, "%d regression(s) over %.1f%%\n", regressions, options.threshold);
+  }
+
+  free(result.millis);
+  for (int phase = 0; phase < HULL_PHASE_COUNT; phase++)
+  {
+    free(result.phaseMillis[phase]);
+    for (int counter = 0; counter < HULL_PERF_COUNTER_COUNT; counter++)
+    {
+      free(result.phaseCounters[phase][counter]);
+    }
+  }
+  for (int i = 0; i < baselineCount; i++)
+  {
+    free(baselines[i].samples);
+  }
+  free(baselines);
+  if (out != stdout) fclose(out);
+  HullSetAllocator(NULL);
+  HullPerfClose(perf);
+  return regressions > 0 ? BENCH_EXIT_REGRESSION : EXIT_SUCCESS;
+}
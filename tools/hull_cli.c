@@ -0,0 +1,398 @@
+// Headless hull computation for machines without a display.
+// Links only the hull library, see the hull_cli target in the Makefile.
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_build.h"
+#include "hull_io.h"
+#include "hull_kernel.h"
+#include "hull_parallel.h"
+#include "hull_polyhedron.h"
+#include "hull_time.h"
+#include "hull_trace.h"
+#include "hull_voxel.h"
+#include "hull_weld.h"
+#include "point_cloud.h"
+#include "point_gen.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_SEED 8742
+#define DEFAULT_EXTENT 5.0f
+
+static const char *engineNames[HULL_ENGINE_COUNT] = { "incremental", "conflict" };
+
+static void fPrintUsage(const char *program)
+{
+  fprintf(stderr,
+    "usage: %s [options] <points.xyz|points.obj>\n"
+    "       %s [options] --generate <distribution> <count>\n"
+    "options:\n"
+    "  -o, --output <file.obj>   write the hull as a Wavefront OBJ\n"
+    "  --engine <name>           incremental or conflict (default conflict)\n"
+    "  --grid <step>             snap the points to a grid of this step and build with exact integer tests\n"
+    "  --spatial-order           insert the points along a Morton curve in randomised rounds, for locality\n"
+    "  --weld <tolerance>        weld points within tolerance of each other before building, 0 = exact duplicates only\n"
+    "  --voxel <resolution>      build an approximate hull from voxel grid corners, at most resolution cells per side\n"
+    "  --epsilon <e>             build the hull of an epsilon-kernel, within e times the bounding box diagonal\n"
+    "  --merge <tolerance>       merge coplanar triangles into polygons, 0 = exactly coplanar only\n"
+    "  --threads <n>             threads used to load or generate points, 0 = every core (default 0)\n"
+    "  --seed <n>                seed for --generate (default %d)\n"
+    "  --save-points <file>      write the input points as text\n"
+    "  --huge-pages              back the point buffer with huge pages\n"
+    "  --trace <file.json>       write a Chrome trace of loading, building and writing\n"
+    "distributions: cube ball sphere gaussian clustered coplanar collinear\n",
+    program, program, DEFAULT_SEED);
+}
+
+static double fMillis(double seconds)
+{
+  return seconds * 1000.0;
+}
+
+static int fCountHullVertices(ConvexShape *convexShape)
+{
+  if (convexShape == NULL) return 0;
+
+  char *used = calloc((size_t)convexShape->vertexCount, 1);
+  int count = 0;
+  for (int i = 0; i < convexShape->triangleCount; i++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int index = convexShape->triangles[i].indices[k];
+      count += !used[index];
+      used[index] = 1;
+    }
+  }
+  for (int i = 0; i < convexShape->edgeCount; i++)
+  {
+    for (int k = 0; k < 2; k++)
+    {
+      int index = convexShape->edges[i].indices[k];
+      count += !used[index];
+      used[index] = 1;
+    }
+  }
+  free(used);
+  return count;
+}
+
+int main(int argc, char **argv)
+{
+  const char *inputFile = NULL;
+  const char *outputFile = NULL;
+  const char *pointsFile = NULL;
+  const char *traceFile = NULL;
+  HullEngine engine = HULL_ENGINE_CONFLICT;
+  float gridStep = 0.0f;
+  bool spatialOrder = false;
+  float weldTolerance = -1.0f;
+  int voxelResolution = 0;
+  float epsilon = 0.0f;
+  float mergeTolerance = -1.0f;
+  int threadCount = 0;
+  unsigned int seed = DEFAULT_SEED;
+  bool hugePages = false;
+  PointDistribution distribution = POINTS_DISTRIBUTION_COUNT;
+  int generateCount = 0;
+
+  for (int i = 1; i < argc; i++)
+  {
+    bool hasValue = i + 1 < argc;
+    if ((strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "--output") == 0) && hasValue)
+    {
+      outputFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--engine") == 0 && hasValue)
+    {
+      i++;
+      engine = HULL_ENGINE_COUNT;
+      for (int e = 0; e < HULL_ENGINE_COUNT; e++)
+      {
+        if (strcmp(argv[i], engineNames[e]) == 0) engine = (HullEngine)e;
+      }
+      if (engine == HULL_ENGINE_COUNT)
+      {
+        fprintf(stderr, "unknown engine: %s\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--grid") == 0 && hasValue)
+    {
+      gridStep = strtof(argv[++i], NULL);
+      if (!(gridStep > 0.0f))
+      {
+        fprintf(stderr, "grid step must be positive: %s\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--spatial-order") == 0)
+    {
+      spatialOrder = true;
+    }
+    else if (strcmp(argv[i], "--weld") == 0 && hasValue)
+    {
+      weldTolerance = strtof(argv[++i], NULL);
+      if (!(weldTolerance >= 0.0f))
+      {
+        fprintf(stderr, "weld tolerance must not be negative: %s\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--voxel") == 0 && hasValue)
+    {
+      voxelResolution = atoi(argv[++i]);
+      if (voxelResolution < 2 || voxelResolution > HULL_VOXEL_MAX_RESOLUTION)
+      {
+        fprintf(stderr, "voxel resolution must be between 2 and %d: %s\n", HULL_VOXEL_MAX_RESOLUTION, argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--epsilon") == 0 && hasValue)
+    {
+      epsilon = strtof(argv[++i], NULL);
+      if (!(epsilon >= HULL_KERNEL_MIN_EPSILON && epsilon <= 1.0f))
+      {
+        fprintf(stderr, "epsilon must be between %g and 1: %s\n", HULL_KERNEL_MIN_EPSILON, argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--merge") == 0 && hasValue)
+    {
+      mergeTolerance = strtof(argv[++i], NULL);
+      if (!(mergeTolerance >= 0.0f))
+      {
+        fprintf(stderr, "merge tolerance must not be negative: %s\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && hasValue)
+    {
+      threadCount = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && hasValue)
+    {
+      seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--save-points") == 0 && hasValue)
+    {
+      pointsFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--huge-pages") == 0)
+    {
+      hugePages = true;
+    }
+    else if (strcmp(argv[i], "--trace") == 0 && hasValue)
+    {
+      traceFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--generate") == 0 && i + 2 < argc)
+    {
+      distribution = GetPointDistributionFromName(argv[++i]);
+      generateCount = atoi(argv[++i]);
+      if (distribution == POINTS_DISTRIBUTION_COUNT || generateCount < 1 || generateCount > MAX_POINT_CLOUD_COUNT)
+      {
+        fPrintUsage(argv[0]);
+        return EXIT_FAILURE;
+      }
+    }
+    else if (argv[i][0] != '-' && inputFile == NULL)
+    {
+      inputFile = argv[i];
+    }
+    else
+    {
+      fPrintUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  if ((inputFile == NULL) == (generateCount == 0))
+  {
+    fPrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  if (threadCount <= 0) threadCount = HullGetThreadCount();
+  if (traceFile != NULL)
+  {
+    HullTraceSetThreadName("main");
+    HullTraceStart(0);
+  }
+
+  // Load
+  HullTraceBegin("load");
+  double start = HullTimeNow();
+  PointCloud cloud = { 0 };
+  if (inputFile != NULL)
+  {
+    if (!LoadPointFile(inputFile, &cloud, hugePages, threadCount))
+    {
+      fprintf(stderr, "failed to load %s\n", inputFile);
+      return EXIT_FAILURE;
+    }
+  }
+  else
+  {
+    cloud = CreatePointCloud(generateCount, hugePages);
+    if (cloud.points == NULL)
+    {
+      fprintf(stderr, "not enough memory for %d points\n", generateCount);
+      return EXIT_FAILURE;
+    }
+    GeneratePoints(cloud.points, cloud.count, distribution, seed, DEFAULT_EXTENT, threadCount);
+  }
+  double loadSeconds = HullTimeNow() - start;
+  HullTraceEnd();
+
+  if (pointsFile != NULL && !SavePointFile(pointsFile, cloud.points, cloud.count))
+  {
+    fprintf(stderr, "failed to write %s\n", pointsFile);
+  }
+
+  // Weld, the hull is built on the welded points
+  double weldSeconds = 0.0;
+  HullWeld *weld = NULL;
+  HullVec3 *points = cloud.points;
+  int pointCount = cloud.count;
+  if (weldTolerance >= 0.0f)
+  {
+    start = HullTimeNow();
+    weld = CreateHullWeld(cloud.points, cloud.count, weldTolerance, threadCount);
+    weldSeconds = HullTimeNow() - start;
+    if (weld == NULL)
+    {
+      fprintf(stderr, "weld tolerance %g is too small for these coordinates\n", weldTolerance);
+      ClearPointCloud(&cloud);
+      return EXIT_FAILURE;
+    }
+    points = weld->points;
+    pointCount = weld->count;
+  }
+
+  // Voxel prefilter, the hull of the candidates encloses the exact one
+  double voxelSeconds = 0.0;
+  HullVoxelFilter *voxel = NULL;
+  if (voxelResolution > 0)
+  {
+    start = HullTimeNow();
+    voxel = CreateHullVoxelFilter(points, pointCount, voxelResolution, threadCount);
+    voxelSeconds = HullTimeNow() - start;
+    points = voxel->points;
+    pointCount = voxel->count;
+  }
+
+  // Epsilon-kernel, only its points reach the build
+  double kernelSeconds = 0.0;
+  HullKernel *kernel = NULL;
+  if (epsilon > 0.0f)
+  {
+    start = HullTimeNow();
+    kernel = CreateHullKernel(points, pointCount, epsilon, threadCount);
+    kernelSeconds = HullTimeNow() - start;
+    points = kernel->points;
+    pointCount = kernel->count;
+  }
+
+  // Build, construction itself is sequential
+  HullTraceBegin("build");
+  start = HullTimeNow();
+  // Voxel corners lie on the voxel grid, exact integer tests are much faster on their coplanar runs
+  float buildGrid = gridStep > 0.0f ? gridStep : voxel != NULL ? voxel->cellSize : 0.0f;
+  HullBuild *build = buildGrid > 0.0f ? HullBuildBeginQuantized(points, pointCount, buildGrid, engine, NULL) : HullBuildBegin(points, pointCount, engine);
+  if (build == NULL)
+  {
+    fprintf(stderr, "points do not fit a grid of step %g\n", buildGrid);
+    ClearHullKernel(kernel);
+    HullMemFree(kernel);
+    ClearHullVoxelFilter(voxel);
+    HullMemFree(voxel);
+    ClearHullWeld(weld);
+    HullMemFree(weld);
+    ClearPointCloud(&cloud);
+    return EXIT_FAILURE;
+  }
+  if (spatialOrder)
+  {
+    HullBuildSpatialOrder(build, threadCount);
+  }
+  HullBuildStep(build, -1);
+  ConvexShape *convexShape = HullBuildSnapshot(build);
+  HullBuildStats stats = build->stats;
+  HullBuildEnd(build);
+  double buildSeconds = HullTimeNow() - start;
+  HullTraceEnd();
+
+  // Merge
+  double mergeSeconds = 0.0;
+  HullPolyhedron *polyhedron = NULL;
+  if (mergeTolerance >= 0.0f)
+  {
+    start = HullTimeNow();
+    polyhedron = CreateHullPolyhedron(convexShape, mergeTolerance);
+    mergeSeconds = HullTimeNow() - start;
+  }
+
+  // Write
+  double writeSeconds = 0.0;
+  bool written = true;
+  if (outputFile != NULL)
+  {
+    HullTraceBegin("write");
+    start = HullTimeNow();
+    written = polyhedron != NULL ? SaveHullPolyhedronObj(outputFile, polyhedron) : SaveConvexShapeObj(outputFile, convexShape);
+    writeSeconds = HullTimeNow() - start;
+    HullTraceEnd();
+    if (!written) fprintf(stderr, "failed to write %s\n", outputFile);
+  }
+
+  int triangleCount = convexShape != NULL ? convexShape->triangleCount : 0;
+  printf("points:    %d\n", cloud.count);
+  printf("engine:    %s\n", engineNames[engine]);
+  printf("threads:   %d\n", threadCount);
+  if (gridStep > 0.0f) printf("grid:      %g\n", gridStep);
+  if (spatialOrder) printf("order:     spatial\n");
+  if (weld != NULL) printf("welded:    %d points, %d merged into others\n", weld->count, weld->inputCount - weld->count);
+  if (voxel != NULL) printf("voxels:    %d candidates, cell %g, error bound %g\n", voxel->count, voxel->cellSize, voxel->errorBound);
+  if (kernel != NULL) printf("kernel:    %d points, epsilon %g, error bound %g\n", kernel->count, kernel->epsilon, kernel->errorBound);
+  printf("hull:      %d triangles, %d vertices%s\n", triangleCount, fCountHullVertices(convexShape),
+    convexShape == NULL ? " (degenerate input)" : convexShape->edgeCount > 0 ? " (collinear input, one segment)" : "");
+  if (polyhedron != NULL)
+  {
+    printf("merged:    %d faces, %d vertices, %d corners\n", polyhedron->faceCount, polyhedron->vertexCount,
+      polyhedron->faceStart[polyhedron->faceCount]);
+  }
+  printf("load ms:   %.3f\n", fMillis(loadSeconds));
+  if (weld != NULL) printf("weld ms:   %.3f\n", fMillis(weldSeconds));
+  if (voxel != NULL) printf("voxel ms:  %.3f\n", fMillis(voxelSeconds));
+  if (kernel != NULL) printf("kernel ms: %.3f\n", fMillis(kernelSeconds));
+  printf("build ms:  %.3f\n", fMillis(buildSeconds));
+  if (polyhedron != NULL) printf("merge ms:  %.3f\n", fMillis(mergeSeconds));
+  printf("write ms:  %.3f\n", fMillis(writeSeconds));
+  if (HULL_STATS_ENABLED)
+  {
+    long long visibleInsertions = stats.insertions - stats.interiorPoints;
+    printf("canSee:    %lld tests\n", stats.canSeeTests);
+    printf("visible:   %.2f faces per insertion, %d max\n", visibleInsertions > 0 ? (double)stats.visibleFaces / visibleInsertions : 0.0, stats.maxVisibleFaces);
+    printf("horizon:   %.2f edges per insertion\n", visibleInsertions > 0 ? (double)stats.horizonEdges / visibleInsertions : 0.0);
+    printf("faces:     %lld created, %lld destroyed, %lld peak live\n", stats.facesCreated, stats.facesDestroyed, stats.peakLiveFaces);
+    printf("interior:  %lld points\n", stats.interiorPoints);
+  }
+  if (traceFile != NULL)
+  {
+    HullTraceStop();
+    if (!HullTraceSave(traceFile)) fprintf(stderr, "failed to write %s\n", traceFile);
+  }
+
+  ClearHullPolyhedron(polyhedron);
+  HullMemFree(polyhedron);
+  ClearConvexShape(convexShape);
+  HullMemFree(convexShape);
+  ClearHullKernel(kernel);
+  HullMemFree(kernel);
+  ClearHullVoxelFilter(voxel);
+  HullMemFree(voxel);
+  ClearHullWeld(weld);
+  HullMemFree(weld);
+  ClearPointCloud(&cloud);
+  return written ? EXIT_SUCCESS : EXIT_FAILURE;
+}
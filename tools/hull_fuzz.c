@@ -0,0 +1,668 @@
+// Differential fuzzing of the hull engines behind CreateConvexShapeEx.
+// Random and adversarial point sets go through every engine, each hull is checked on its own
+// (closed, Euler characteristic, locally convex, every input point inside) and against the others
+// (each hull contains the other's vertices), and the build's history replayed to the end must give the same hull.
+// Every hull is merged into polygon faces at tolerance 0 and at a positive tolerance, which must stay closed
+// and convex with every corner and every input point within tolerance of the face planes.
+// Failing inputs are shrunk and written as point files.
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_build.h"
+#include "hull_history.h"
+#include "hull_io.h"
+#include "hull_polyhedron.h"
+#include "hull_predicates.h"
+#include "point_cloud.h"
+#include "point_gen.h"
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FUZZ_DEFAULT_ITERATIONS 1000
+#define FUZZ_DEFAULT_SEED 8742
+#define FUZZ_DEFAULT_MAX_POINTS 200
+// Smallest input, generated or minimised
+#define FUZZ_MIN_POINTS 4
+// Merge tolerance of the polygon face check, relative to the largest coordinate
+#define FUZZ_MERGE_TOLERANCE 1e-2
+// Rounding allowed on top of it, the face planes are floats
+#define FUZZ_PLANE_SLACK 1e-5
+
+static const char *engineNames[HULL_ENGINE_COUNT] = { "incremental", "conflict" };
+
+typedef enum FuzzCase {
+  FUZZ_UNIFORM = 0,    // Cube, ball or sphere from point_gen
+  FUZZ_DUPLICATES,     // Few distinct points repeated many times
+  FUZZ_COPLANAR,       // Exactly on an axis plane, a few points off it
+  FUZZ_GRID,           // Integer lattice, many coplanar and cospherical quadruples
+  FUZZ_NEAR_DEGENERATE, // Slab or needle thinner than float precision at the extent
+  FUZZ_HUGE_RANGE,     // Coordinates from 1e-6 to 1e10 mixed
+  FUZZ_CASE_COUNT
+} FuzzCase;
+
+static const char *caseNames[FUZZ_CASE_COUNT] = { "uniform", "duplicates", "coplanar", "grid", "nearDegenerate", "hugeRange" };
+
+typedef enum FuzzFailure {
+  FUZZ_OPEN = 1,          // A directed edge without its reverse, or one used twice
+  FUZZ_EULER = 2,         // V - E + F != 2
+  FUZZ_CONCAVE = 4,       // A neighbour face bends outwards at a shared edge
+  FUZZ_OUTSIDE = 8,       // An input point above a face
+  FUZZ_DISAGREE = 16,     // A vertex of one engine outside the other engine's hull
+  FUZZ_DEGENERATE = 32,   // One engine found a hull, another did not
+  FUZZ_BAD_INDEX = 64,    // Triangle index out of range
+  FUZZ_HISTORY = 128,     // The history's final state is not the built hull
+  FUZZ_DOUBLE = 256,      // The double build of the same points gave another hull
+  FUZZ_POLYHEDRON = 512   // Merged faces not closed, not convex or off their planes by more than the tolerance
+} FuzzFailure;
+
+static const char *failureNames[] = { "open", "euler", "concave", "outside", "disagree", "degenerate", "badIndex", "history", "double", "polyhedron" };
+#define FUZZ_FAILURE_KINDS 10
+
+typedef struct FuzzOptions {
+  int iterations;
+  uint64_t seed;
+  int maxPoints;
+  bool engines[HULL_ENGINE_COUNT];
+  const char *outputDir;
+  const char *replayFile;
+  bool verbose;
+} FuzzOptions;
+
+//------------------------------------------------------------------------------------
+// Inputs
+//------------------------------------------------------------------------------------
+static uint64_t fNextRandom(uint64_t *state)
+{
+  // SplitMix64
+  uint64_t x = (*state += 0x9E3779B97F4A7C15ULL);
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+  return x ^ (x >> 31);
+}
+
+static int fRandomInt(uint64_t *state, int low, int high)
+{
+  return low + (int)(fNextRandom(state) % (uint64_t)(high - low + 1));
+}
+
+// Uniform in [-1, 1)
+static double fRandomUnit(uint64_t *state)
+{
+  return (double)(fNextRandom(state) >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+}
+
+static HullVec3 fRandomPoint(uint64_t *state, double scale)
+{
+  return (HullVec3){ (float)(fRandomUnit(state) * scale), (float)(fRandomUnit(state) * scale), (float)(fRandomUnit(state) * scale) };
+}
+
+static void fGenerateCase(FuzzCase fuzzCase, HullVec3 *points, int count, uint64_t *state)
+{
+  switch (fuzzCase)
+  {
+    case FUZZ_UNIFORM:
+    {
+      static const PointDistribution distributions[] = { POINTS_UNIFORM_CUBE, POINTS_UNIFORM_BALL, POINTS_SPHERE_SURFACE };
+      PointDistribution distribution = distributions[fRandomInt(state, 0, 2)];
+      GeneratePoints(points, count, distribution, (unsigned int)fNextRandom(state), 5.0f, 1);
+      break;
+    }
+    case FUZZ_DUPLICATES:
+    {
+      int distinct = fRandomInt(state, 4, 12);
+      for (int i = 0; i < count; i++)
+      {
+        points[i] = i < distinct ? fRandomPoint(state, 5.0) : points[fRandomInt(state, 0, distinct - 1)];
+      }
+      break;
+    }
+    case FUZZ_COPLANAR:
+    {
+      int axis = fRandomInt(state, 0, 2);
+      int offPlane = fRandomInt(state, 0, 2);
+      // Entirely flat input takes the 2D path, half of it on a line
+      bool collinear = offPlane == 0 && fRandomInt(state, 0, 1);
+      for (int i = 0; i < count; i++)
+      {
+        points[i] = fRandomPoint(state, 5.0);
+        if (i >= offPlane) ((float *)&points[i])[axis] = 1.0f;
+        if (collinear) ((float *)&points[i])[(axis + 1) % 3] = -2.0f;
+      }
+      break;
+    }
+    case FUZZ_GRID:
+    {
+      int side = fRandomInt(state, 2, 5);
+      for (int i = 0; i < count; i++)
+      {
+        points[i] = (HullVec3){ (float)fRandomInt(state, 0, side), (float)fRandomInt(state, 0, side), (float)fRandomInt(state, 0, side) };
+      }
+      break;
+    }
+    case FUZZ_NEAR_DEGENERATE:
+    {
+      bool needle = fRandomInt(state, 0, 1);
+      double thickness = pow(10.0, -fRandomInt(state, 4, 8));
+      for (int i = 0; i < count; i++)
+      {
+        points[i] = (HullVec3){
+          (float)(fRandomUnit(state) * 5.0),
+          (float)(fRandomUnit(state) * (needle ? thickness : 5.0)),
+          (float)(fRandomUnit(state) * thickness)
+        };
+      }
+      break;
+    }
+    default:
+    {
+      for (int i = 0; i < count; i++)
+      {
+        points[i] = fRandomPoint(state, pow(10.0, fRandomInt(state, -6, 10)));
+      }
+      break;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------------
+// Checks, with the library's exact orientation so the checker is not fooled by the rounding it looks for
+//------------------------------------------------------------------------------------
+typedef struct FuzzHull {
+  ConvexShape *shape;
+  bool valid; // Indices in range, the cross checks may look at it
+} FuzzHull;
+
+// Above the plane of the face, the side its counter-clockwise normal points to. Exact
+static bool fAboveFace(const ConvexShape *shape, int face, HullVec3 p)
+{
+  const int *indices = shape->triangles[face].indices;
+  return HullOrient3d(shape->vertices[indices[0]], shape->vertices[indices[1]], shape->vertices[indices[2]], p) > 0.0;
+}
+
+// On the segment of a collinear hull, exact: on its line and between its ends in every coordinate
+static bool fOnSegment(const ConvexShape *shape, HullVec3 p)
+{
+  HullVec3 a = shape->vertices[shape->edges[0].indices[0]];
+  HullVec3 b = shape->vertices[shape->edges[0].indices[1]];
+  if (!HullCollinear(a, b, p)) return false;
+  return p.x >= fminf(a.x, b.x) && p.x <= fmaxf(a.x, b.x)
+    && p.y >= fminf(a.y, b.y) && p.y <= fmaxf(a.y, b.y)
+    && p.z >= fminf(a.z, b.z) && p.z <= fmaxf(a.z, b.z);
+}
+
+static bool fInsideHull(const FuzzHull *hull, HullVec3 p)
+{
+  if (hull->shape->edgeCount > 0) return fOnSegment(hull->shape, p);
+  for (int f = 0; f < hull->shape->triangleCount; f++)
+  {
+    if (fAboveFace(hull->shape, f, p)) return false;
+  }
+  return true;
+}
+
+typedef struct FuzzEdge {
+  long long key; // from * vertexCount + to
+  int face;
+} FuzzEdge;
+
+static int fCompareEdges(const void *a, const void *b)
+{
+  long long x = ((const FuzzEdge *)a)->key;
+  long long y = ((const FuzzEdge *)b)->key;
+  return (x > y) - (x < y);
+}
+
+static const FuzzEdge *fFindEdge(const FuzzEdge *edges, int edgeCount, long long key)
+{
+  FuzzEdge probe = { key, 0 };
+  return bsearch(&probe, edges, edgeCount, sizeof(FuzzEdge), fCompareEdges);
+}
+
+// Collinear input: one segment with every point on it
+static int fCheckSegment(const ConvexShape *shape, HullVec3 *points, int count)
+{
+  if (shape->edgeCount != 1 || shape->triangleCount != 0) return FUZZ_OPEN;
+  for (int i = 0; i < count; i++)
+  {
+    if (!fOnSegment(shape, points[i])) return FUZZ_OUTSIDE;
+  }
+  return 0;
+}
+
+// Checks one hull on its own, marks it valid for the cross checks
+static int fCheckHull(FuzzHull *hull, HullVec3 *points, int count)
+{
+  ConvexShape *shape = hull->shape;
+  int faceCount = shape->triangleCount;
+  long long vertexCount = shape->vertexCount;
+  int failures = 0;
+  for (int f = 0; f < faceCount; f++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int index = shape->triangles[f].indices[k];
+      if (index < 0 || index >= vertexCount) return FUZZ_BAD_INDEX;
+    }
+  }
+  for (int e = 0; e < shape->edgeCount; e++)
+  {
+    for (int k = 0; k < 2; k++)
+    {
+      int index = shape->edges[e].indices[k];
+      if (index < 0 || index >= vertexCount) return FUZZ_BAD_INDEX;
+    }
+  }
+
+  hull->valid = true;
+  if (shape->edgeCount > 0) return fCheckSegment(shape, points, count);
+
+  // Closure: every directed edge once, and its reverse once
+  int edgeCount = faceCount * 3;
+  FuzzEdge *edges = malloc(sizeof(FuzzEdge) * (edgeCount > 0 ? edgeCount : 1));
+  char *usedVertex = calloc((size_t)vertexCount, 1);
+  int usedCount = 0;
+  for (int f = 0; f < faceCount; f++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      int from = shape->triangles[f].indices[k];
+      int to = shape->triangles[f].indices[(k + 1) % 3];
+      edges[f * 3 + k] = (FuzzEdge){ from * vertexCount + to, f };
+      usedCount += !usedVertex[from];
+      usedVertex[from] = 1;
+    }
+  }
+  qsort(edges, edgeCount, sizeof(FuzzEdge), fCompareEdges);
+  for (int e = 0; e < edgeCount; e++)
+  {
+    if (e > 0 && edges[e].key == edges[e - 1].key) failures |= FUZZ_OPEN;
+    long long from = edges[e].key / vertexCount;
+    long long to = edges[e].key % vertexCount;
+    const FuzzEdge *reverse = fFindEdge(edges, edgeCount, to * vertexCount + from);
+    if (reverse == NULL)
+    {
+      failures |= FUZZ_OPEN;
+      continue;
+    }
+    // Local convexity: the far corner of the neighbour lies below this face
+    const int *neighbour = shape->triangles[reverse->face].indices;
+    for (int k = 0; k < 3; k++)
+    {
+      if (neighbour[k] == from || neighbour[k] == to) continue;
+      if (fAboveFace(shape, edges[e].face, shape->vertices[neighbour[k]])) failures |= FUZZ_CONCAVE;
+    }
+  }
+  if (!(failures & FUZZ_OPEN) && usedCount - edgeCount / 2 + faceCount != 2) failures |= FUZZ_EULER;
+
+  for (int i = 0; i < count; i++)
+  {
+    if (!fInsideHull(hull, points[i]))
+    {
+      failures |= FUZZ_OUTSIDE;
+      break;
+    }
+  }
+  free(usedVertex);
+  free(edges);
+  return failures;
+}
+
+// Every vertex of a, triangle corners or segment ends, inside b
+static bool fContainsVertices(const FuzzHull *b, const FuzzHull *a)
+{
+  for (int f = 0; f < a->shape->triangleCount; f++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      if (!fInsideHull(b, a->shape->vertices[a->shape->triangles[f].indices[k]])) return false;
+    }
+  }
+  for (int e = 0; e < a->shape->edgeCount; e++)
+  {
+    for (int k = 0; k < 2; k++)
+    {
+      if (!fInsideHull(b, a->shape->vertices[a->shape->edges[e].indices[k]])) return false;
+    }
+  }
+  return true;
+}
+
+// Triangle with its smallest index first, keeping the winding
+static ConvexShapeTriangle fCanonicalTriangle(ConvexShapeTriangle t)
+{
+  int first = 0;
+  for (int k = 1; k < 3; k++)
+  {
+    if (t.indices[k] < t.indices[first]) first = k;
+  }
+  return (ConvexShapeTriangle){ { t.indices[first], t.indices[(first + 1) % 3], t.indices[(first + 2) % 3] } };
+}
+
+static int fCompareTriangles(const void *a, const void *b)
+{
+  const int *x = ((const ConvexShapeTriangle *)a)->indices;
+  const int *y = ((const ConvexShapeTriangle *)b)->indices;
+  for (int k = 0; k < 3; k++)
+  {
+    if (x[k] != y[k]) return x[k] < y[k] ? -1 : 1;
+  }
+  return 0;
+}
+
+// Same triangles, in any order and rotation, and the same segment
+static bool fSameShape(const ConvexShape *a, const ConvexShape *b)
+{
+  if (a == NULL || b == NULL) return a == b;
+  if (a->triangleCount != b->triangleCount || a->edgeCount != b->edgeCount) return false;
+  for (int e = 0; e < a->edgeCount; e++)
+  {
+    const int *x = a->edges[e].indices, *y = b->edges[e].indices;
+    if (!((x[0] == y[0] && x[1] == y[1]) || (x[0] == y[1] && x[1] == y[0]))) return false;
+  }
+  int count = a->triangleCount;
+  ConvexShapeTriangle *sorted = malloc(sizeof(ConvexShapeTriangle) * (size_t)(2 * count + 1));
+  for (int f = 0; f < count; f++)
+  {
+    sorted[f] = fCanonicalTriangle(a->triangles[f]);
+    sorted[count + f] = fCanonicalTriangle(b->triangles[f]);
+  }
+  qsort(sorted, count, sizeof(ConvexShapeTriangle), fCompareTriangles);
+  qsort(sorted + count, count, sizeof(ConvexShapeTriangle), fCompareTriangles);
+  bool same = memcmp(sorted, sorted + count, sizeof(ConvexShapeTriangle) * (size_t)count) == 0;
+  free(sorted);
+  return same;
+}
+
+// Builds again with a history, as the viewer does, and seeks it to the end: flat and collinear input included
+static int fCheckHistory(HullVec3 *points, int count, HullEngine engine, const ConvexShape *shape)
+{
+  HullHistory *history = CreateHullHistory(points, count);
+  HullBuild *build = HullBuildBegin(points, count, engine);
+  if (build != NULL)
+  {
+    build->history = history;
+    HullBuildStep(build, -1);
+    HullBuildEnd(build);
+  }
+  bool same = fSameShape(HullHistorySeek(history, -1), shape);
+  ClearHullHistory(history);
+  HullMemFree(history);
+  return same ? 0 : FUZZ_HISTORY;
+}
+
+// Builds again on the points widened to double. The predicates are exact on both, so is the hull the same.
+static int fCheckDouble(HullVec3 *points, int count, HullEngine engine, const ConvexShape *shape)
+{
+  HullVec3d *wide = malloc(sizeof(HullVec3d) * (size_t)count);
+  for (int i = 0; i < count; i++) wide[i] = HullVec3ToDouble(points[i]);
+  ConvexShape *precise = CreateConvexShapeDouble(wide, count, -1, engine);
+  bool same = fSameShape(precise, shape);
+  ClearConvexShape(precise);
+  HullMemFree(precise);
+  free(wide);
+  return same ? 0 : FUZZ_DOUBLE;
+}
+
+// Merges the hull's faces at tolerance and checks V - E + F = 2, every corner within tolerance of its face's plane
+// and bending inwards by no more than tolerance, and every input point within tolerance below every face plane.
+// slack covers the rounding of the float planes.
+static int fCheckPolyhedron(const ConvexShape *shape, HullVec3 *points, int count, float tolerance, double slack)
+{
+  HullPolyhedron *polyhedron = CreateHullPolyhedron(shape, tolerance);
+  if (polyhedron == NULL) return FUZZ_POLYHEDRON;
+  double limit = tolerance + slack;
+  int indexCount = polyhedron->faceStart[polyhedron->faceCount];
+  bool failed = polyhedron->faceCount < 2 || indexCount % 2 != 0
+    || polyhedron->vertexCount - indexCount / 2 + polyhedron->faceCount != 2;
+  for (int f = 0; f < polyhedron->faceCount && !failed; f++)
+  {
+    const int *corners = polyhedron->indices + polyhedron->faceStart[f];
+    int cornerCount = polyhedron->faceStart[f + 1] - polyhedron->faceStart[f];
+    HullVec3d normal = HullVec3ToDouble(polyhedron->planes[f].normal);
+    double offset = polyhedron->planes[f].offset;
+    failed = cornerCount < 3;
+    for (int k = 0; k < cornerCount && !failed; k++)
+    {
+      int p = corners[(k + cornerCount - 1) % cornerCount], q = corners[k], r = corners[(k + 1) % cornerCount];
+      failed = p < 0 || q < 0 || r < 0 || p >= polyhedron->vertexCount || q >= polyhedron->vertexCount || r >= polyhedron->vertexCount;
+      if (failed) break;
+      HullVec3d a = HullVec3ToDouble(polyhedron->vertices[p]);
+      HullVec3d b = HullVec3ToDouble(polyhedron->vertices[q]);
+      HullVec3d c = HullVec3ToDouble(polyhedron->vertices[r]);
+      failed = fabs(HullVec3dDotProduct(normal, b) - offset) > limit;
+      // Seen along the normal, an inward corner's depth is its distance from the line through its neighbours
+      HullVec3d ab = HullVec3dSubtract(b, a), ac = HullVec3dSubtract(c, a);
+      double turn = HullVec3dDotProduct(HullVec3dCrossProduct(ab, ac), normal);
+      HullVec3d across = HullVec3dSubtract(ac, HullVec3dScale(normal, HullVec3dDotProduct(ac, normal)));
+      double length = sqrt(HullVec3dDotProduct(across, across));
+      if (turn < 0.0 && length > 0.0) failed |= -turn / length > limit;
+    }
+    for (int i = 0; i < count && !failed; i++)
+    {
+      failed = HullVec3dDotProduct(normal, HullVec3ToDouble(points[i])) - offset > limit;
+    }
+  }
+  ClearHullPolyhedron(polyhedron);
+  HullMemFree(polyhedron);
+  return failed ? FUZZ_POLYHEDRON : 0;
+}
+
+// Builds with every selected engine and returns the failure bits
+static int fRunCase(const FuzzOptions *options, HullVec3 *points, int count)
+{
+  FuzzHull hulls[HULL_ENGINE_COUNT] = { 0 };
+  int failures = 0;
+  int built = 0;
+  int selected = 0;
+  for (int e = 0; e < HULL_ENGINE_COUNT; e++)
+  {
+    if (!options->engines[e]) continue;
+    selected++;
+    hulls[e].shape = CreateConvexShapeEx(points, count, -1, (HullEngine)e);
+    failures |= fCheckHistory(points, count, (HullEngine)e, hulls[e].shape);
+    failures |= fCheckDouble(points, count, (HullEngine)e, hulls[e].shape);
+    if (hulls[e].shape == NULL) continue;
+    built++;
+    failures |= fCheckHull(&hulls[e], points, count);
+  }
+
+  // Polygon faces of the first good hull with area, at tolerance 0 and at a fraction of the extent
+  double scale = 0.0;
+  for (int i = 0; i < count; i++)
+  {
+    scale = fmax(scale, fmax(fabs(points[i].x), fmax(fabs(points[i].y), fabs(points[i].z))));
+  }
+  for (int e = 0; e < HULL_ENGINE_COUNT && failures == 0; e++)
+  {
+    if (!hulls[e].valid || hulls[e].shape->triangleCount == 0) continue;
+    failures |= fCheckPolyhedron(hulls[e].shape, points, count, 0.0f, FUZZ_PLANE_SLACK * scale);
+    failures |= fCheckPolyhedron(hulls[e].shape, points, count, (float)(FUZZ_MERGE_TOLERANCE * scale), FUZZ_PLANE_SLACK * scale);
+    break;
+  }
+  if (built > 0 && built < selected) failures |= FUZZ_DEGENERATE;
+
+  for (int a = 0; a < HULL_ENGINE_COUNT && !(failures & FUZZ_BAD_INDEX); a++)
+  {
+    for (int b = 0; b < HULL_ENGINE_COUNT; b++)
+    {
+      if (a == b || !hulls[a].valid || !hulls[b].valid) continue;
+      if (!fContainsVertices(&hulls[b], &hulls[a])) failures |= FUZZ_DISAGREE;
+    }
+  }
+
+  for (int e = 0; e < HULL_ENGINE_COUNT; e++)
+  {
+    ClearConvexShape(hulls[e].shape);
+    HullMemFree(hulls[e].shape);
+  }
+  return failures;
+}
+
+// Removes chunks of points while exactly the same failure bits remain, halving the chunk when nothing can go.
+// Never below FUZZ_MIN_POINTS, smaller inputs take other paths and would fail for other reasons.
+static int fMinimize(const FuzzOptions *options, HullVec3 *points, int count, int failures)
+{
+  HullVec3 *candidate = malloc(sizeof(HullVec3) * count);
+  for (int chunk = count / 2; chunk >= 1;)
+  {
+    bool removed = false;
+    for (int start = 0; start < count && count - chunk >= FUZZ_MIN_POINTS;)
+    {
+      int end = start + chunk < count ? start + chunk : count;
+      memcpy(candidate, points, sizeof(HullVec3) * start);
+      memcpy(candidate + start, points + end, sizeof(HullVec3) * (count - end));
+      int candidateCount = count - (end - start);
+      if (fRunCase(options, candidate, candidateCount) == failures)
+      {
+        memcpy(points, candidate, sizeof(HullVec3) * candidateCount);
+        count = candidateCount;
+        removed = true;
+      }
+      else
+      {
+        start = end;
+      }
+    }
+    if (!removed) chunk /= 2;
+    if (chunk > count / 2) chunk = count / 2;
+  }
+  free(candidate);
+  return count;
+}
+
+static void fPrintFailures(FILE *out, int failures)
+{
+  for (int k = 0, first = 1; k < FUZZ_FAILURE_KINDS; k++)
+  {
+    if (!(failures & (1 << k))) continue;
+    fprintf(out, "%s%s", first ? "" : ",", failureNames[k]);
+    first = 0;
+  }
+}
+
+//------------------------------------------------------------------------------------
+// Options
+//------------------------------------------------------------------------------------
+static void fPrintUsage(const char *program)
+{
+  fprintf(stderr,
+    "usage: %s [options]\n"
+    "  --iterations <n>           inputs to try (default %d)\n"
+    "  --seed <n>                 first seed, every iteration derives its own (default %d)\n"
+    "  --max-points <n>           largest input (default %d)\n"
+    "  --engines <name,...>       incremental,conflict (default both)\n"
+    "  --output-dir <dir>         where minimised failures are written (default .)\n"
+    "  --replay <file>            check one point file instead of fuzzing\n"
+    "  --verbose                  print every input\n",
+    program, FUZZ_DEFAULT_ITERATIONS, FUZZ_DEFAULT_SEED, FUZZ_DEFAULT_MAX_POINTS);
+}
+
+static bool fParseOptions(int argc, char **argv, FuzzOptions *options)
+{
+  *options = (FuzzOptions){
+    .iterations = FUZZ_DEFAULT_ITERATIONS,
+    .seed = FUZZ_DEFAULT_SEED,
+    .maxPoints = FUZZ_DEFAULT_MAX_POINTS,
+    .outputDir = "."
+  };
+  for (int i = 0; i < HULL_ENGINE_COUNT; i++) options->engines[i] = true;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--verbose") == 0)
+    {
+      options->verbose = true;
+      continue;
+    }
+    if (i + 1 >= argc) return false;
+    char *value = argv[++i];
+    const char *option = argv[i - 1];
+    if (strcmp(option, "--iterations") == 0) options->iterations = atoi(value);
+    else if (strcmp(option, "--seed") == 0) options->seed = strtoull(value, NULL, 10);
+    else if (strcmp(option, "--max-points") == 0) options->maxPoints = atoi(value);
+    else if (strcmp(option, "--output-dir") == 0) options->outputDir = value;
+    else if (strcmp(option, "--replay") == 0) options->replayFile = value;
+    else if (strcmp(option, "--engines") == 0)
+    {
+      memset(options->engines, 0, sizeof(options->engines));
+      for (char *name = strtok(value, ","); name != NULL; name = strtok(NULL, ","))
+      {
+        int found = -1;
+        for (int e = 0; e < HULL_ENGINE_COUNT; e++)
+        {
+          if (strcmp(name, engineNames[e]) == 0) found = e;
+        }
+        if (found < 0) return false;
+        options->engines[found] = true;
+      }
+    }
+    else return false;
+  }
+  return options->iterations > 0 && options->maxPoints >= FUZZ_MIN_POINTS && options->maxPoints <= MAX_POINT_CLOUD_COUNT;
+}
+
+int main(int argc, char **argv)
+{
+  FuzzOptions options;
+  if (!fParseOptions(argc, argv, &options))
+  {
+    fPrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  if (options.replayFile != NULL)
+  {
+    PointCloud cloud = { 0 };
+    if (!LoadPointFile(options.replayFile, &cloud, false, 1))
+    {
+      fprintf(stderr, "failed to load %s\n", options.replayFile);
+      return EXIT_FAILURE;
+    }
+    int failures = fRunCase(&options, cloud.points, cloud.count);
+    printf("%s: %d points, ", options.replayFile, cloud.count);
+    if (failures) fPrintFailures(stdout, failures);
+    else printf("ok");
+    printf("\n");
+    ClearPointCloud(&cloud);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+
+  HullVec3 *points = malloc(sizeof(HullVec3) * options.maxPoints);
+  int failureCount = 0;
+  int caseFailures[FUZZ_CASE_COUNT] = { 0 };
+  for (int iteration = 0; iteration < options.iterations; iteration++)
+  {
+    uint64_t state = options.seed * 0x9E3779B97F4A7C15ULL + (uint64_t)iteration;
+    FuzzCase fuzzCase = (FuzzCase)(iteration % FUZZ_CASE_COUNT);
+    int count = fRandomInt(&state, FUZZ_MIN_POINTS, options.maxPoints);
+    fGenerateCase(fuzzCase, points, count, &state);
+
+    int failures = fRunCase(&options, points, count);
+    if (options.verbose)
+    {
+      printf("%5d %-15s %5d points %s\n", iteration, caseNames[fuzzCase], count, failures ? "FAIL" : "ok");
+    }
+    if (!failures) continue;
+
+    failureCount++;
+    caseFailures[fuzzCase]++;
+    int minimized = fMinimize(&options, points, count, failures);
+    char fileName[1024];
+    snprintf(fileName, sizeof(fileName), "%s/fuzz_%s_%llu_%d.xyz", options.outputDir, caseNames[fuzzCase], (unsigned long long)options.seed, iteration);
+    bool saved = SavePointFile(fileName, points, minimized);
+    printf("iteration %d, %s, %d points: ", iteration, caseNames[fuzzCase], count);
+    fPrintFailures(stdout, failures);
+    printf(" -> %d points%s%s\n", minimized, saved ? " in " : " (could not write the file)", saved ? fileName : "");
+  }
+  free(points);
+
+  printf("%d of %d inputs failed", failureCount, options.iterations);
+  for (int c = 0; c < FUZZ_CASE_COUNT; c++)
+  {
+    if (caseFailures[c]) printf(", %s %d", caseNames[c], caseFailures[c]);
+  }
+  printf("\n");
+  return failureCount > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
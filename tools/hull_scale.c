@@ -0,0 +1,446 @@
+// Scaling study: sweeps thread counts and input sizes over the parallel stages of the hull code.
+// Reports speedup and efficiency against one thread, the bandwidth each stage reaches,
+// and fits time ~ n^k per stage so O(n log n) (k slightly above 1) and O(n^2) (k near 2) stand out.
+#include "hull_core.h"
+#include "convex_hull.h"
+#include "hull_build.h"
+#include "hull_io.h"
+#include "hull_parallel.h"
+#include "hull_time.h"
+#include "point_cloud.h"
+#include "point_gen.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCALE_MAX_SIZES 16
+#define SCALE_MAX_THREAD_COUNTS 32 // Entries of the sweep
+#define SCALE_MAX_THREADS 256
+#define SCALE_DEFAULT_REPEAT 3
+#define SCALE_DEFAULT_SEED 8742
+#define SCALE_DEFAULT_BATCH 64
+#define SCALE_DEFAULT_INCREMENTAL_MAX 10000
+#define SCALE_DEFAULT_SCRATCH "hull_scale_points.xyz"
+#define SCALE_EXTENT 5.0f
+
+// Stages that can use more than one thread, plus hull construction which is sequential
+// and only measured for its complexity exponent
+typedef enum ScaleStage {
+  SCALE_GENERATE = 0, // GeneratePoints
+  SCALE_PARSE,        // LoadPointFile
+  SCALE_BUILD,        // One hull, every selected engine
+  SCALE_BATCH,        // Independent hulls over a slice of the points each, one per task
+  SCALE_STAGE_COUNT
+} ScaleStage;
+
+static const char *stageNames[SCALE_STAGE_COUNT] = { "generate", "parse", "build", "batch" };
+static const char *engineNames[HULL_ENGINE_COUNT] = { "incremental", "conflict" };
+
+typedef struct ScaleOptions {
+  int sizes[SCALE_MAX_SIZES];
+  int sizeCount;
+  int maxThreads;
+  bool stages[SCALE_STAGE_COUNT];
+  bool engines[HULL_ENGINE_COUNT];
+  PointDistribution distribution;
+  int repeat;
+  unsigned int seed;
+  int batch;                 // Hulls per batch
+  int incrementalMax;
+  const char *outputFile;
+  const char *scratchFile;   // Point file written for the parse stage
+} ScaleOptions;
+
+// One measured stage x engine x size x thread count
+typedef struct ScaleSample {
+  ScaleStage stage;
+  int engine;                // -1 outside the build stage
+  int count;
+  int threads;
+  double seconds;            // Median
+  double bytes;              // Least data the stage has to read and write
+} ScaleSample;
+
+//------------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------------
+static int fCompareDoubles(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static double fMedian(double *samples, int count)
+{
+  qsort(samples, count, sizeof(double), fCompareDoubles);
+  return count % 2 ? samples[count / 2] : 0.5 * (samples[count / 2 - 1] + samples[count / 2]);
+}
+
+// Least squares slope of log(seconds) over log(count), NAN with fewer than two sizes
+static double fFitExponent(const ScaleSample *samples, int sampleCount, ScaleStage stage, int engine, int threads)
+{
+  double sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0;
+  int n = 0;
+  for (int i = 0; i < sampleCount; i++)
+  {
+    const ScaleSample *sample = &samples[i];
+    if (sample->stage != stage || sample->engine != engine || sample->threads != threads || sample->seconds <= 0.0) continue;
+    double x = log((double)sample->count);
+    double y = log(sample->seconds);
+    sumX += x;
+    sumY += y;
+    sumXX += x * x;
+    sumXY += x * y;
+    n++;
+  }
+  double denominator = n * sumXX - sumX * sumX;
+  if (n < 2 || denominator <= 0.0) return NAN;
+  return (n * sumXY - sumX * sumY) / denominator;
+}
+
+static const ScaleSample *fFindSample(const ScaleSample *samples, int sampleCount, ScaleStage stage, int engine, int count, int threads)
+{
+  for (int i = 0; i < sampleCount; i++)
+  {
+    const ScaleSample *sample = &samples[i];
+    if (sample->stage == stage && sample->engine == engine && sample->count == count && sample->threads == threads) return sample;
+  }
+  return NULL;
+}
+
+//------------------------------------------------------------------------------------
+// Stages
+//------------------------------------------------------------------------------------
+static void fBuildHull(HullVec3 *points, int count, HullEngine engine)
+{
+  HullBuild *build = HullBuildBegin(points, count, engine);
+  HullBuildStep(build, -1);
+  ConvexShape *convexShape = HullBuildSnapshot(build);
+  HullBuildEnd(build);
+  ClearConvexShape(convexShape);
+  HullMemFree(convexShape);
+}
+
+// HullParallelFor only splits large loops, a batch has few and long tasks so it gets its own pool
+typedef struct ScaleBatch {
+  HullVec3 *points;
+  int count;
+  int hullCount;
+  atomic_int nextHull;
+} ScaleBatch;
+
+static void *fBatchThread(void *arg)
+{
+  ScaleBatch *batch = arg;
+  int hull;
+  while ((hull = atomic_fetch_add(&batch->nextHull, 1)) < batch->hullCount)
+  {
+    int begin = (int)((long long)batch->count * hull / batch->hullCount);
+    int end = (int)((long long)batch->count * (hull + 1) / batch->hullCount);
+    fBuildHull(batch->points + begin, end - begin, HULL_ENGINE_CONFLICT);
+  }
+  return NULL;
+}
+
+static void fRunBatch(HullVec3 *points, int count, int hullCount, int threadCount)
+{
+  ScaleBatch batch = { points, count, hullCount };
+  atomic_init(&batch.nextHull, 0);
+  pthread_t threads[SCALE_MAX_THREADS];
+  for (int t = 1; t < threadCount; t++)
+  {
+    pthread_create(&threads[t], NULL, fBatchThread, &batch);
+  }
+  fBatchThread(&batch);
+  for (int t = 1; t < threadCount; t++)
+  {
+    pthread_join(threads[t], NULL);
+  }
+}
+
+// Seconds of one run, the median over the repeats is taken by the caller
+static double fRunStage(const ScaleOptions *options, ScaleStage stage, int engine, PointCloud *cloud, int threads)
+{
+  double start = HullTimeNow();
+  switch (stage)
+  {
+    case SCALE_GENERATE:
+      GeneratePoints(cloud->points, cloud->count, options->distribution, options->seed, SCALE_EXTENT, threads);
+      break;
+    case SCALE_PARSE:
+    {
+      PointCloud loaded = { 0 };
+      if (!LoadPointFile(options->scratchFile, &loaded, false, threads))
+      {
+        fprintf(stderr, "failed to load %s\n", options->scratchFile);
+      }
+      // Freeing is not part of the parse
+      double seconds = HullTimeNow() - start;
+      ClearPointCloud(&loaded);
+      return seconds;
+    }
+    case SCALE_BUILD:
+      fBuildHull(cloud->points, cloud->count, (HullEngine)engine);
+      break;
+    default:
+      fRunBatch(cloud->points, cloud->count, options->batch, threads);
+      break;
+  }
+  return HullTimeNow() - start;
+}
+
+static long long fFileSize(const char *fileName)
+{
+  FILE *file = fopen(fileName, "rb");
+  if (file == NULL) return 0;
+  fseek(file, 0, SEEK_END);
+  long long size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+//------------------------------------------------------------------------------------
+// Options
+//------------------------------------------------------------------------------------
+static void fPrintUsage(const char *program)
+{
+  fprintf(stderr,
+    "usage: %s [options]\n"
+    "  --sizes <n,n,...>          point counts (default 1000,10000,100000,1000000)\n"
+    "  --threads <n>              largest thread count, swept in powers of two (default every core)\n"
+    "  --stages <name,...>        generate,parse,build,batch (default all)\n"
+    "  --engines <name,...>       engines of the build stage (default both)\n"
+    "  --distribution <name>      point distribution (default sphere, every point is on the hull)\n"
+    "  --repeat <n>               timed runs per measurement, the median is reported (default %d)\n"
+    "  --seed <n>                 point seed (default %d)\n"
+    "  --batch <n>                hulls per batch, each over count / n points (default %d)\n"
+    "  --incremental-max <n>      largest size built with the incremental engine (default %d)\n"
+    "  --scratch <file>           point file for the parse stage (default %s)\n"
+    "  -o, --output <file>        write the JSON there instead of stdout\n",
+    program, SCALE_DEFAULT_REPEAT, SCALE_DEFAULT_SEED, SCALE_DEFAULT_BATCH, SCALE_DEFAULT_INCREMENTAL_MAX, SCALE_DEFAULT_SCRATCH);
+}
+
+static bool fParseNameList(char *list, const char *const names[], int nameCount, bool selected[])
+{
+  memset(selected, 0, sizeof(bool) * nameCount);
+  for (char *name = strtok(list, ","); name != NULL; name = strtok(NULL, ","))
+  {
+    int found = -1;
+    for (int i = 0; i < nameCount; i++)
+    {
+      if (strcmp(name, names[i]) == 0) found = i;
+    }
+    if (found < 0) return false;
+    selected[found] = true;
+  }
+  return true;
+}
+
+static bool fParseOptions(int argc, char **argv, ScaleOptions *options)
+{
+  *options = (ScaleOptions){
+    .sizes = { 1000, 10000, 100000, 1000000 },
+    .sizeCount = 4,
+    .maxThreads = HullGetThreadCount(),
+    .distribution = POINTS_SPHERE_SURFACE,
+    .repeat = SCALE_DEFAULT_REPEAT,
+    .seed = SCALE_DEFAULT_SEED,
+    .batch = SCALE_DEFAULT_BATCH,
+    .incrementalMax = SCALE_DEFAULT_INCREMENTAL_MAX,
+    .scratchFile = SCALE_DEFAULT_SCRATCH
+  };
+  for (int i = 0; i < SCALE_STAGE_COUNT; i++) options->stages[i] = true;
+  for (int i = 0; i < HULL_ENGINE_COUNT; i++) options->engines[i] = true;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (i + 1 >= argc) return false;
+    char *value = argv[++i];
+    const char *option = argv[i - 1];
+    if (strcmp(option, "--sizes") == 0)
+    {
+      options->sizeCount = 0;
+      for (char *size = strtok(value, ","); size != NULL && options->sizeCount < SCALE_MAX_SIZES; size = strtok(NULL, ","))
+      {
+        int count = atoi(size);
+        if (count < 4 || count > MAX_POINT_CLOUD_COUNT) return false;
+        options->sizes[options->sizeCount++] = count;
+      }
+    }
+    else if (strcmp(option, "--stages") == 0)
+    {
+      if (!fParseNameList(value, stageNames, SCALE_STAGE_COUNT, options->stages)) return false;
+    }
+    else if (strcmp(option, "--engines") == 0)
+    {
+      if (!fParseNameList(value, engineNames, HULL_ENGINE_COUNT, options->engines)) return false;
+    }
+    else if (strcmp(option, "--distribution") == 0)
+    {
+      options->distribution = GetPointDistributionFromName(value);
+      if (options->distribution == POINTS_DISTRIBUTION_COUNT) return false;
+    }
+    else if (strcmp(option, "--threads") == 0) options->maxThreads = atoi(value);
+    else if (strcmp(option, "--repeat") == 0) options->repeat = atoi(value);
+    else if (strcmp(option, "--seed") == 0) options->seed = (unsigned int)strtoul(value, NULL, 10);
+    else if (strcmp(option, "--batch") == 0) options->batch = atoi(value);
+    else if (strcmp(option, "--incremental-max") == 0) options->incrementalMax = atoi(value);
+    else if (strcmp(option, "--scratch") == 0) options->scratchFile = value;
+    else if (strcmp(option, "-o") == 0 || strcmp(option, "--output") == 0) options->outputFile = value;
+    else return false;
+  }
+  return options->repeat > 0 && options->sizeCount > 0 && options->batch > 0
+    && options->maxThreads > 0 && options->maxThreads <= SCALE_MAX_THREADS;
+}
+
+// 1, 2, 4, ... and the largest count itself
+static int fThreadCounts(int maxThreads, int threadCounts[])
+{
+  int count = 0;
+  for (int t = 1; t < maxThreads && count < SCALE_MAX_THREAD_COUNTS - 1; t *= 2)
+  {
+    threadCounts[count++] = t;
+  }
+  threadCounts[count++] = maxThreads;
+  return count;
+}
+
+//------------------------------------------------------------------------------------
+// Output
+//------------------------------------------------------------------------------------
+static void fWriteSample(FILE *out, bool first, const ScaleSample *sample, const ScaleSample *single)
+{
+  double speedup = single != NULL && sample->seconds > 0.0 ? single->seconds / sample->seconds : 1.0;
+  fprintf(out, "%s\n    {\"stage\": \"%s\", \"engine\": ", first ? "" : ",", stageNames[sample->stage]);
+  if (sample->engine >= 0) fprintf(out, "\"%s\"", engineNames[sample->engine]);
+  else fprintf(out, "null");
+  fprintf(out, ", \"points\": %d, \"threads\": %d, \"medianMs\": %.4f, \"speedup\": %.3f, \"efficiency\": %.3f, \"bytesPerSecond\": %.0f}",
+    sample->count, sample->threads, sample->seconds * 1000.0, speedup, speedup / sample->threads,
+    sample->seconds > 0.0 ? sample->bytes / sample->seconds : 0.0);
+
+  fprintf(stderr, "%-9s %-12s %9d pts %3d thr %11.3f ms  speedup %5.2f  eff %4.2f  %8.1f MB/s\n",
+    stageNames[sample->stage], sample->engine >= 0 ? engineNames[sample->engine] : "", sample->count, sample->threads,
+    sample->seconds * 1000.0, speedup, speedup / sample->threads, sample->seconds > 0.0 ? sample->bytes / sample->seconds / 1e6 : 0.0);
+}
+
+static void fWriteExponent(FILE *out, bool first, ScaleStage stage, int engine, int threads, double exponent)
+{
+  fprintf(out, "%s\n    {\"stage\": \"%s\", \"engine\": ", first ? "" : ",", stageNames[stage]);
+  if (engine >= 0) fprintf(out, "\"%s\"", engineNames[engine]);
+  else fprintf(out, "null");
+  fprintf(out, ", \"threads\": %d, \"exponent\": ", threads);
+  if (isnan(exponent)) fprintf(out, "null}");
+  else fprintf(out, "%.3f}", exponent);
+
+  if (!isnan(exponent))
+  {
+    fprintf(stderr, "%-9s %-12s %3d thr  time ~ n^%.2f\n", stageNames[stage], engine >= 0 ? engineNames[engine] : "", threads, exponent);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ScaleOptions options;
+  if (!fParseOptions(argc, argv, &options))
+  {
+    fPrintUsage(argv[0]);
+    return EXIT_FAILURE;
+  }
+  FILE *out = options.outputFile != NULL ? fopen(options.outputFile, "w") : stdout;
+  if (out == NULL)
+  {
+    fprintf(stderr, "failed to open %s\n", options.outputFile);
+    return EXIT_FAILURE;
+  }
+
+  int threadCounts[SCALE_MAX_THREAD_COUNTS];
+  int threadCountCount = fThreadCounts(options.maxThreads, threadCounts);
+  int maxSamples = options.sizeCount * (SCALE_STAGE_COUNT + HULL_ENGINE_COUNT) * threadCountCount;
+  ScaleSample *samples = malloc(sizeof(ScaleSample) * maxSamples);
+  int sampleCount = 0;
+  double *runs = malloc(sizeof(double) * options.repeat);
+
+  fprintf(out, "{\n  \"version\": 1,\n  \"seed\": %u,\n  \"repeat\": %d,\n  \"distribution\": \"%s\",\n  \"batch\": %d,\n  \"results\": [",
+    options.seed, options.repeat, GetPointDistributionName(options.distribution), options.batch);
+  bool first = true;
+  for (int s = 0; s < options.sizeCount; s++)
+  {
+    int count = options.sizes[s];
+    PointCloud cloud = CreatePointCloud(count, false);
+    if (cloud.points == NULL)
+    {
+      fprintf(stderr, "not enough memory for %d points, size skipped\n", count);
+      continue;
+    }
+    GeneratePoints(cloud.points, count, options.distribution, options.seed, SCALE_EXTENT, 0);
+    double pointBytes = (double)count * sizeof(HullVec3);
+    double fileBytes = 0.0;
+    if (options.stages[SCALE_PARSE])
+    {
+      if (!SavePointFile(options.scratchFile, cloud.points, count))
+      {
+        fprintf(stderr, "failed to write %s\n", options.scratchFile);
+        return EXIT_FAILURE;
+      }
+      fileBytes = (double)fFileSize(options.scratchFile);
+    }
+
+    for (int stage = 0; stage < SCALE_STAGE_COUNT; stage++)
+    {
+      if (!options.stages[stage]) continue;
+      for (int engine = stage == SCALE_BUILD ? 0 : -1; engine < (stage == SCALE_BUILD ? HULL_ENGINE_COUNT : 0); engine++)
+      {
+        if (engine >= 0 && (!options.engines[engine] || (engine == HULL_ENGINE_INCREMENTAL && count > options.incrementalMax))) continue;
+        // A single hull build is sequential, extra threads would only repeat the same number
+        int stageThreadCounts = stage == SCALE_BUILD ? 1 : threadCountCount;
+        for (int t = 0; t < stageThreadCounts; t++)
+        {
+          int threads = threadCounts[t];
+          fRunStage(&options, (ScaleStage)stage, engine, &cloud, threads); // Warmup
+          for (int run = 0; run < options.repeat; run++)
+          {
+            runs[run] = fRunStage(&options, (ScaleStage)stage, engine, &cloud, threads);
+          }
+          ScaleSample *sample = &samples[sampleCount++];
+          *sample = (ScaleSample){ (ScaleStage)stage, engine, count, threads, fMedian(runs, options.repeat), pointBytes };
+          if (stage == SCALE_PARSE) sample->bytes += fileBytes;
+
+          const ScaleSample *single = fFindSample(samples, sampleCount, (ScaleStage)stage, engine, count, 1);
+          fWriteSample(out, first, sample, single);
+          fflush(out);
+          first = false;
+        }
+      }
+    }
+    ClearPointCloud(&cloud);
+  }
+  if (options.stages[SCALE_PARSE]) remove(options.scratchFile);
+
+  // Exponents at one thread and at the largest thread count
+  fprintf(out, "\n  ],\n  \"complexity\": [");
+  first = true;
+  for (int stage = 0; stage < SCALE_STAGE_COUNT; stage++)
+  {
+    if (!options.stages[stage]) continue;
+    for (int engine = stage == SCALE_BUILD ? 0 : -1; engine < (stage == SCALE_BUILD ? HULL_ENGINE_COUNT : 0); engine++)
+    {
+      if (engine >= 0 && !options.engines[engine]) continue;
+      int fitThreads[2] = { 1, stage == SCALE_BUILD ? 1 : options.maxThreads };
+      for (int f = 0; f < (fitThreads[1] > 1 ? 2 : 1); f++)
+      {
+        fWriteExponent(out, first, (ScaleStage)stage, engine, fitThreads[f], fFitExponent(samples, sampleCount, (ScaleStage)stage, engine, fitThreads[f]));
+        first = false;
+      }
+    }
+  }
+  fprintf(out, "\n  ]\n}\n");
+
+  free(runs);
+  free(samples);
+  if (out != stdout) fclose(out);
+  return EXIT_SUCCESS;
+}